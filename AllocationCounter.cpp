@@ -0,0 +1,35 @@
+#include "Benchmark.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Nur im Target SnakeBenchmark gelinkt: ersetzt den globalen operator new, damit der Benchmark
+// Allokationen pro Tick pruefen kann. Das Spiel-Binary allokiert weiter ueber die Standardversion.
+
+namespace {
+    std::atomic<size_t> allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+size_t Benchmark::allocationCount() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+bool Benchmark::countsAllocations() {
+    return true;
+}
@@ -0,0 +1,78 @@
+#include "Arena.h"
+#include <algorithm>
+#include <cstdint>
+
+Arena::Arena(size_t initialBlockSize, std::pmr::memory_resource *upstream)
+        : upstream(upstream),
+          initialBlockSize(std::max<size_t>(initialBlockSize, 1024)) {
+    blocks.reserve(16);
+}
+
+Arena::~Arena() {
+    for (const Block &block : blocks) {
+        upstream->deallocate(block.data, block.size, alignof(std::max_align_t));
+    }
+}
+
+size_t Arena::capacity() const {
+    size_t total = 0;
+    for (const Block &block : blocks) {
+        total += block.size;
+    }
+    return total;
+}
+
+void Arena::addBlock(size_t minSize) {
+    // Geometrisch wachsen, damit ein Tick nur wenige Bloecke braucht
+    size_t size = blocks.empty() ? initialBlockSize : blocks.back().size * 2;
+    size = std::max(size, minSize);
+    blocks.push_back(Block{static_cast<std::byte*>(upstream->allocate(size, alignof(std::max_align_t))), size});
+    upstreamCount++;
+}
+
+void *Arena::do_allocate(size_t bytes, size_t alignment) {
+    while (true) {
+        if (current < blocks.size()) {
+            const Block &block = blocks[current];
+            const auto base = reinterpret_cast<uintptr_t>(block.data);
+            const uintptr_t aligned = (base + offset + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+            const size_t start = aligned - base;
+            if (start + bytes <= block.size) {
+                used += start + bytes - offset;
+                offset = start + bytes;
+                peak = std::max(peak, used);
+                return block.data + start;
+            }
+            // Passt nicht mehr: im naechsten (behaltenen) Block weitermachen
+            if (current + 1 < blocks.size()) {
+                current++;
+                offset = 0;
+                continue;
+            }
+        }
+        addBlock(bytes + alignment);
+        current = blocks.size() - 1;
+        offset = 0;
+    }
+}
+
+void Arena::reset() {
+    // Hat ein Tick mehrere Bloecke gebraucht, ab jetzt einen zusammenhaengenden nehmen
+    if (blocks.size() > 1) {
+        const size_t total = capacity();
+        for (const Block &block : blocks) {
+            upstream->deallocate(block.data, block.size, alignof(std::max_align_t));
+        }
+        blocks.clear();
+        addBlock(total);
+    }
+    current = 0;
+    offset = 0;
+    used = 0;
+}
+
+void Arena::rewind(const Marker &marker) {
+    current = marker.block;
+    offset = marker.offset;
+    used = marker.used;
+}
@@ -0,0 +1,80 @@
+#ifndef SNAKEGAME_ARENA_H
+#define SNAKEGAME_ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// Bump-Allocator fuer kurzlebige Such-/Planungspuffer, als std::pmr::memory_resource nutzbar.
+// Einzelne Freigaben sind No-ops, reset() gibt alles auf einmal frei. Die Bloecke bleiben dabei
+// erhalten (mehrere werden zu einem grossen zusammengelegt), im eingeschwungenen Zustand
+// kommt also kein malloc mehr an. Nicht thread-sicher: eine Arena pro Tick-Thread.
+class Arena : public std::pmr::memory_resource {
+public:
+    // Stand der Arena, auf den rewind() zurueckspringt (Stack-artige Nutzung innerhalb eines Ticks)
+    struct Marker {
+        size_t block = 0;
+        size_t offset = 0;
+        size_t used = 0;
+    };
+
+    explicit Arena(size_t initialBlockSize = 64 * 1024,
+                   std::pmr::memory_resource *upstream = std::pmr::new_delete_resource());
+    ~Arena() override;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Alles freigeben, Speicher behalten
+    void reset();
+    [[nodiscard]] Marker mark() const { return {current, offset, used}; }
+    void rewind(const Marker &marker);
+
+    [[nodiscard]] size_t bytesUsed() const { return used; }
+    [[nodiscard]] size_t peakBytes() const { return peak; }
+    [[nodiscard]] size_t capacity() const;
+    [[nodiscard]] size_t blockCount() const { return blocks.size(); }
+    [[nodiscard]] size_t upstreamAllocations() const { return upstreamCount; }
+
+private:
+    struct Block {
+        std::byte *data;
+        size_t size;
+    };
+
+    std::pmr::memory_resource *upstream;
+    size_t initialBlockSize;
+    std::vector<Block> blocks;
+    size_t current = 0;     // aktueller Block
+    size_t offset = 0;      // Fuellstand im aktuellen Block
+    size_t used = 0;        // Bytes seit dem letzten reset()
+    size_t peak = 0;
+    size_t upstreamCount = 0;
+
+    void addBlock(size_t minSize);
+
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *, size_t, size_t) override {}  // Freigabe erst bei reset()/rewind()
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// Gibt beim Verlassen des Scopes alles frei, was seitdem aus der Arena kam.
+// Mit einer anderen memory_resource als Arena passiert nichts.
+// Die Container muessen nach dem Scope-Objekt deklariert werden (werden also vorher zerstoert).
+class ArenaScope {
+public:
+    explicit ArenaScope(std::pmr::memory_resource *resource)
+            : arena(dynamic_cast<Arena*>(resource)), marker(arena ? arena->mark() : Arena::Marker{}) {}
+    ~ArenaScope() {
+        if (arena) arena->rewind(marker);
+    }
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    Arena *arena;
+    Arena::Marker marker;
+};
+
+#endif //SNAKEGAME_ARENA_H
@@ -0,0 +1,570 @@
+#include "Benchmark.h"
+#include "game.h"
+#include "HierarchicalPathfinder.h"
+#include "ParallelBFS.h"
+#include "MovingAI.h"
+#include "PerfCounters.h"
+#include "SlicedSearch.h"
+#include "MoveSafety.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <thread>
+
+namespace {
+    const char* algorithmName(Pathfinder::Algorithm algo) {
+        switch (algo) {
+            case Pathfinder::Algorithm::BFS:      return "BFS";
+            case Pathfinder::Algorithm::DIJKSTRA: return "Dijkstra";
+            case Pathfinder::Algorithm::DISTANCE_FIELD: return "Distanzfeld";
+            case Pathfinder::Algorithm::HIERARCHICAL: return "HPA*";
+            case Pathfinder::Algorithm::DSTAR_LITE: return "DStarLite";
+            case Pathfinder::Algorithm::PARALLEL_BFS: return "ParallelBFS";
+        }
+        return "?";
+    }
+
+    // Regressionsfall MoveSafety: Schlange laeuft nach RECHTS, geplant ist OBEN in eine Tasche aus
+    // einer Zelle, rechts ist Wand, links der eigene Body. Einziger sicherer Zug ist UNTEN, also
+    // senkrecht zur Laufrichtung, aber die Umkehr des Plans. Das Spiel setzt die Richtung vor der
+    // Pruefung schon auf den Plan; UNTEN darf trotzdem nicht als Umkehr wegfallen.
+    bool checkMoveSafetyEscape() {
+        Grid grid(10, 8, true);
+        for (const Point &wall : {Point(3, 3), Point(5, 3), Point(4, 2), Point(5, 4)}) {
+            grid.setCell(wall, CellType::WALL);
+        }
+        Snake snake(Point(1, 4), grid.getBreite(), grid.getHohe(), Direction::RIGHT);
+        for (int i = 0; i < 3; i++) {
+            snake.grow();
+            snake.move();
+        }
+        const Direction travel = snake.getDirection();
+        snake.setDirection(Direction::UP);      // wie getNextAIMove()
+
+        MoveSafety safety;
+        const Direction chosen = safety.chooseSafest(grid, snake, Direction::UP, travel);
+        snake.setDirection(travel);
+        snake.setDirection(chosen);
+        return snake.getHeadPosition() == Point(4, 4) && chosen == Direction::DOWN
+               && snake.getDirection() == Direction::DOWN;
+    }
+}
+
+#ifndef SNAKE_COUNT_ALLOCATIONS
+// Im Spiel-Binary bleibt operator new unangetastet, gezaehlt wird nur in SnakeBenchmark
+// (AllocationCounter.cpp)
+size_t Benchmark::allocationCount() {
+    return 0;
+}
+
+bool Benchmark::countsAllocations() {
+    return false;
+}
+#endif
+
+int Benchmark::run(const Options &options) {
+    using Clock = std::chrono::steady_clock;
+    const Pathfinder::Algorithm algorithms[] = {Pathfinder::Algorithm::BFS, Pathfinder::Algorithm::DIJKSTRA,
+                                                 Pathfinder::Algorithm::DISTANCE_FIELD, Pathfinder::Algorithm::DSTAR_LITE};
+    bool allocationFree = true;
+
+    // Hoechstens ein Viertel des Bretts, sonst findet spawnFood irgendwann keine freie Zelle mehr
+    const int foodItems = std::min(options.foodItems, options.breite * options.hohe / 4);
+
+    std::cout << "Benchmark: " << options.breite << "x" << options.hohe << ", "
+              << options.ticks << " Ticks pro Algorithmus (Aufwaermen: " << options.warmupTicks << ")";
+    if (foodItems > 0) {
+        std::cout << ", " << foodItems << " Essen";
+    }
+    const SlicedSearch::Budget budget{options.searchNodeBudget, std::chrono::microseconds(options.searchMicrosBudget)};
+    if (!budget.unlimited()) {
+        std::cout << ", Suchbudget " << budget.nodes << " Knoten/" << budget.time.count() << " us pro Tick";
+    }
+    if (options.speculate) {
+        std::cout << ", Spekulation im Hintergrund";
+    }
+    std::cout << "\n";
+    if (!countsAllocations()) {
+        std::cout << "  Allokationen werden hier nicht gezaehlt, dafuer SnakeBenchmark starten\n";
+    }
+    const bool safetyOk = checkMoveSafetyEscape();
+    std::cout << (safetyOk ? "  MoveSafety-Selbsttest: ok\n"
+                           : "  FEHLER: MoveSafety verwirft den einzigen sicheren Zug (senkrecht zur Laufrichtung)\n");
+    // Ein Zaehler-Satz fuer alle Algorithmen, pro Algorithmus zurueckgesetzt
+    PerfCounters counters;
+    if (!counters.available()) {
+        std::cout << "  Hardware-Zaehler nicht verfuegbar: " << counters.unavailableReason() << "\n";
+    }
+
+    for (Pathfinder::Algorithm algo : algorithms) {
+        Game game(options.breite, options.hohe);
+        if (foodItems > 0) {
+            game.setMaxFoodItems(foodItems);
+            game.reset();
+        }
+        game.setAlgorithm(algo);
+        game.toggleAutoPlay();
+        if (!budget.unlimited()) {
+            game.setSearchBudget(budget);
+        }
+        if (options.speculate) {
+            game.setSpeculative(true);
+        }
+        if (!options.resumePath.empty()) {
+            GameSnapshot snapshot;
+            if (!snapshot.loadFromFile(options.resumePath) || !game.restoreSnapshot(snapshot)) {
+                return 1;
+            }
+            game.setAlgorithm(algo);
+            if (!game.isAutoPlay()) game.toggleAutoPlay();
+        }
+        if (!options.recordPath.empty()) {
+            game.startRecording(options.recordPath + "." + algorithmName(algo));
+        }
+        if (!options.videoPath.empty()) {
+            // Algorithmus vor die Endung, die bestimmt das Format
+            std::filesystem::path videoPath(options.videoPath);
+            const std::filesystem::path extension = videoPath.extension();
+            videoPath.replace_extension();
+            videoPath += std::string(".") + algorithmName(algo);
+            videoPath += extension;
+            game.startVideo(videoPath.string(), options.videoCellSize);
+        }
+
+        long long measuredTicks = 0;
+        long long steadyTicks = 0;
+        long long steadyAllocations = 0;
+        long long ticksWithAllocations = 0;
+        long long levelTicks = 0;
+        long long levelAllocations = 0;
+        int gamesOver = 0;
+        size_t nodesExpanded = 0;
+        Clock::duration tickTime{};
+        Clock::duration worstTick{};
+        counters.reset();
+
+        for (int i = 0; i < options.warmupTicks + options.ticks; i++) {
+            // Neustart baut Snake/Pathfinder neu auf und zaehlt nicht als eingeschwungen.
+            // Levelwechsel werden getrennt gezaehlt (Hindernis-Pruefung laeuft ueber die Tick-Arena)
+            bool restarted = false;
+            if (game.isGameOver()) {
+                gamesOver++;
+                game.reset();
+                game.setAlgorithm(algo);
+                restarted = true;
+            }
+            const int levelBefore = game.getLevel();
+
+            // Zaehler nur in gemessenen Ticks, die ioctls liegen ausserhalb der Zeitmessung
+            const bool measured = i >= options.warmupTicks;
+            if (measured) counters.start();
+            const size_t allocBefore = allocationCount();
+            const auto start = Clock::now();
+            game.tick();
+            const auto end = Clock::now();
+            if (measured) counters.stop();
+            const size_t allocDuring = allocationCount() - allocBefore;
+
+            if (i < options.warmupTicks) continue;
+            measuredTicks++;
+            tickTime += end - start;
+            worstTick = std::max(worstTick, end - start);
+            nodesExpanded += game.getLastNodesExpanded();
+
+            if (!restarted && game.getLevel() != levelBefore) {
+                levelTicks++;
+                levelAllocations += static_cast<long long>(allocDuring);
+            } else if (!restarted && !game.isGameOver()) {
+                steadyTicks++;
+                steadyAllocations += static_cast<long long>(allocDuring);
+                if (allocDuring > 0) ticksWithAllocations++;
+            }
+        }
+
+        const double microsPerTick = measuredTicks > 0
+                ? std::chrono::duration<double, std::micro>(tickTime).count() / static_cast<double>(measuredTicks)
+                : 0.0;
+        std::cout << "  " << algorithmName(algo) << ": "
+                  << microsPerTick << " us/Tick (max " << std::chrono::duration<double, std::micro>(worstTick).count()
+                  << "), "
+                  << (measuredTicks > 0 ? nodesExpanded / static_cast<size_t>(measuredTicks) : 0) << " Knoten/Tick, "
+                  << steadyAllocations << " Allokationen in " << steadyTicks << " eingeschwungenen Ticks ("
+                  << ticksWithAllocations << " Ticks mit Allokation), Game Over: " << gamesOver << "\n";
+        if (counters.available()) {
+            std::cout << "    Zaehler: ";
+            counters.print(std::cout, static_cast<double>(measuredTicks), "Tick");
+            std::cout << "\n";
+        }
+        if (options.speculate) {
+            const SpeculativePlanner &speculative = game.getSpeculative();
+            std::cout << "    Spekulation: " << speculative.hitCount() << " Treffer, "
+                      << speculative.discardCount() << " verworfen, " << speculative.skipCount()
+                      << " uebersprungen (Thread beschaeftigt), " << speculative.waitCount()
+                      << " mal auf den Planer-Thread gewartet\n";
+        }
+        const Arena &arena = game.getTickArena();
+        std::cout << "    Levelwechsel: " << levelAllocations << " Allokationen in " << levelTicks << " Ticks; "
+                  << "Tick-Arena: Spitze " << arena.peakBytes() / 1024 << " KB, "
+                  << arena.blockCount() << " Block/Bloecke mit " << arena.capacity() / 1024 << " KB, "
+                  << arena.upstreamAllocations() << " Upstream-Allokationen gesamt\n";
+        // Snapshot/Restore des Endzustands (soll im Mikrosekunden-Bereich bleiben)
+        {
+            constexpr int ROUNDS = 1000;
+            GameSnapshot snapshot;
+            game.saveSnapshot(snapshot);
+            const auto saveStart = Clock::now();
+            for (int r = 0; r < ROUNDS; r++) game.saveSnapshot(snapshot);
+            const auto restoreStart = Clock::now();
+            for (int r = 0; r < ROUNDS; r++) game.restoreSnapshot(snapshot);
+            const auto restoreEnd = Clock::now();
+            std::cout << "    Snapshot: " << snapshot.size() << " Bytes, speichern "
+                      << std::chrono::duration<double, std::micro>(restoreStart - saveStart).count() / ROUNDS
+                      << " us, laden "
+                      << std::chrono::duration<double, std::micro>(restoreEnd - restoreStart).count() / ROUNDS
+                      << " us\n";
+        }
+        if (game.getRecorder().isOpen()) {
+            game.stopRecording();
+            const TrajectoryWriter &recorder = game.getRecorder();
+            const uint64_t raw = recorder.rawBytes();
+            std::cout << "    Aufzeichnung: " << recorder.ticksRecorded() << " Ticks, "
+                      << static_cast<double>(raw) / static_cast<double>(recorder.ticksRecorded()) << " Bytes/Tick roh, "
+                      << recorder.writtenBytes() / 1024 << " KB geschrieben, "
+                      << recorder.stallCount() << " mal auf den Schreib-Thread gewartet\n";
+        }
+        if (game.getVideo().isOpen()) {
+            game.stopVideo();
+            const VideoExporter &video = game.getVideo();
+            std::cout << "    Video: " << video.framesSubmitted() << " Frames, "
+                      << video.writtenBytes() / (1024 * 1024) << " MB geschrieben, "
+                      << video.stallCount() << " mal auf den Schreib-Thread gewartet\n";
+        }
+        if (steadyAllocations > 0 || levelAllocations > 0) {
+            allocationFree = false;
+        }
+    }
+
+    std::cout << (allocationFree ? "OK: eingeschwungene Ticks allokieren nicht\n"
+                                 : "FEHLER: eingeschwungene Ticks allokieren noch\n");
+    return allocationFree && safetyOk ? 0 : 1;
+}
+
+int Benchmark::runQueries(const Options &options, int queries) {
+    using Clock = std::chrono::steady_clock;
+    auto micros = [](Clock::duration d) { return std::chrono::duration<double, std::micro>(d).count(); };
+    // Flache BFS auf riesigen Grids dauert pro Anfrage zig Millisekunden, also nur eine Stichprobe
+    constexpr int BFS_SAMPLES = 20;
+
+    Grid grid(options.breite, options.hohe, true);
+    ObstacleGenerator obstacles(&grid);
+    obstacles.generateMazeWalls(0.25f);
+    const Point center(options.breite / 2, options.hohe / 2);
+    grid.setCell(center, CellType::EMPTY);
+    const Snake snake(center, options.breite, options.hohe);
+
+    std::cout << "Pfadanfragen: " << options.breite << "x" << options.hohe << " Labyrinth, "
+              << queries << " Anfragen (BFS-Stichprobe: " << BFS_SAMPLES << ")\n";
+
+    HierarchicalPathfinder hpa;
+    const auto buildStart = Clock::now();
+    hpa.prepare(grid);
+    const auto buildEnd = Clock::now();
+    hpa.takeNodesExpanded();
+    std::cout << "  HPA*-Aufbau: " << micros(buildEnd - buildStart) / 1000.0 << " ms, "
+              << hpa.clusterCount() << " Cluster, " << hpa.nodeCount() << " Knoten\n";
+
+    // Zufaellige freie Paare, fester Seed fuer vergleichbare Laeufe
+    std::mt19937 rng(4242);
+    std::uniform_int_distribution<int> distX(1, options.breite - 2);
+    std::uniform_int_distribution<int> distY(1, options.hohe - 2);
+    auto randomFree = [&] {
+        while (true) {
+            const Point p(distX(rng), distY(rng));
+            if (grid.getCell(p) != CellType::WALL) return p;
+        }
+    };
+
+    BFSPathfinder bfs;
+    ParallelBFSPathfinder parallelBfs;
+    std::vector<Point> hpaPath;
+    std::vector<Point> bfsPath;
+    std::vector<Point> parallelPath;
+    hpaPath.reserve(static_cast<size_t>(options.breite) * options.hohe);
+    bfsPath.reserve(static_cast<size_t>(options.breite) * options.hohe);
+    parallelPath.reserve(static_cast<size_t>(options.breite) * options.hohe);
+    Clock::duration hpaTime{};
+    Clock::duration bfsTime{};
+    Clock::duration parallelTime{};
+    int parallelMismatches = 0;
+    PerfCounters hpaCounters;
+    PerfCounters bfsCounters;
+    PerfCounters parallelCounters;
+    Clock::duration worst{};
+    size_t hpaExpanded = 0;
+    size_t bfsExpanded = 0;
+    double lengthRatio = 0.0;
+    int compared = 0;
+    int missed = 0;
+    for (int q = 0; q < queries; q++) {
+        const Point start = randomFree();
+        const Point goal = randomFree();
+        hpaCounters.start();
+        const auto t0 = Clock::now();
+        const bool found = hpa.findPath(start, goal, grid, snake, hpaPath);
+        const auto t1 = Clock::now();
+        hpaCounters.stop();
+        hpaTime += t1 - t0;
+        worst = std::max(worst, t1 - t0);
+        hpaExpanded += hpa.takeNodesExpanded();
+        if (q >= BFS_SAMPLES) continue;
+
+        bfsCounters.start();
+        const auto t2 = Clock::now();
+        const bool reachable = bfs.findPath(start, goal, grid, snake, bfsPath);
+        bfsTime += Clock::now() - t2;
+        bfsCounters.stop();
+        bfsExpanded += bfs.takeNodesExpanded();
+
+        // Parallele BFS muss dieselbe Distanz liefern
+        parallelCounters.start();
+        const auto t3 = Clock::now();
+        const bool parallelFound = parallelBfs.findPath(start, goal, grid, snake, parallelPath);
+        parallelTime += Clock::now() - t3;
+        parallelCounters.stop();
+        if (parallelFound != reachable || parallelPath.size() != bfsPath.size()) {
+            parallelMismatches++;
+        }
+        if (reachable && !found) {
+            missed++;
+        } else if (reachable && !bfsPath.empty()) {
+            lengthRatio += static_cast<double>(hpaPath.size()) / static_cast<double>(bfsPath.size());
+            compared++;
+        }
+    }
+    const int samples = std::min(queries, BFS_SAMPLES);
+    std::cout << "  HPA*: " << micros(hpaTime) / queries << " us/Anfrage (max " << micros(worst) << " us), "
+              << hpaExpanded / queries << " Knoten/Anfrage\n";
+    std::cout << "  BFS:  " << micros(bfsTime) / samples << " us/Anfrage, " << bfsExpanded / samples << " Knoten/Anfrage\n";
+    std::cout << "  Parallele BFS: " << micros(parallelTime) / samples << " us/Anfrage, Abweichungen zur BFS: "
+              << parallelMismatches << "\n";
+    if (hpaCounters.available()) {
+        std::cout << "  Zaehler HPA*: ";
+        hpaCounters.print(std::cout, queries, "Anfrage");
+        std::cout << "\n  Zaehler BFS:  ";
+        bfsCounters.print(std::cout, samples, "Anfrage");
+        // Die Worker-Threads zaehlen nicht mit, nur der Anteil des aufrufenden Threads
+        std::cout << "\n  Zaehler parallele BFS (nur aufrufender Thread): ";
+        parallelCounters.print(std::cout, samples, "Anfrage");
+        std::cout << "\n";
+    } else {
+        std::cout << "  Hardware-Zaehler nicht verfuegbar: " << hpaCounters.unavailableReason() << "\n";
+    }
+    std::cout << "  Pfadlaenge HPA*/BFS: " << (compared > 0 ? lengthRatio / compared : 0.0)
+              << " (Mittel ueber " << compared << "), nicht gefunden: " << missed << "\n";
+
+    // Zeitscheiben: dieselben Anfragen fortsetzbar mit festem Budget pro Aufruf. Die Suche laeuft
+    // zum Kopf einer Schlange, die deshalb pro Anfrage am Start steht
+    int slicedMismatches = 0;
+    {
+        const SlicedSearch::Budget budget{options.searchNodeBudget > 0 ? options.searchNodeBudget : 4096,
+                                          std::chrono::microseconds(options.searchMicrosBudget)};
+        SlicedSearch sliced;
+        std::vector<Point> slicedPath;
+        Clock::duration worstSlice{};
+        Clock::duration slicedTime{};
+        long long totalSlices = 0;
+        for (int q = 0; q < samples; q++) {
+            const Point start = randomFree();
+            const Point goal = randomFree();
+            const Snake startSnake(start, options.breite, options.hohe);
+            const bool reachable = bfs.findPath(start, goal, grid, startSnake, bfsPath);
+            sliced.start(grid, goal);
+            SlicedSearch::Status status = SlicedSearch::Status::RUNNING;
+            while (status == SlicedSearch::Status::RUNNING) {
+                const auto t0 = Clock::now();
+                status = sliced.step(grid, startSnake, budget);
+                slicedTime += Clock::now() - t0;
+                worstSlice = std::max(worstSlice, Clock::now() - t0);
+            }
+            totalSlices += sliced.sliceCount();
+            const bool found = status == SlicedSearch::Status::FOUND
+                               && sliced.pathFrom(grid, startSnake, start, slicedPath);
+            if (found != reachable || (found && slicedPath.size() != bfsPath.size())) {
+                slicedMismatches++;
+            }
+        }
+        bfs.takeNodesExpanded();
+        std::cout << "  Zeitscheiben (" << budget.nodes << " Knoten/" << budget.time.count() << " us): "
+                  << static_cast<double>(totalSlices) / samples << " Aufrufe/Anfrage, "
+                  << micros(slicedTime) / static_cast<double>(std::max(1LL, totalSlices)) << " us/Aufruf (max "
+                  << micros(worstSlice) << "), Abweichungen zur BFS: " << slicedMismatches << "\n";
+    }
+
+    // Lokale Aenderung: eine Wand mitten im Grid, danach darf nur die Umgebung neu gebaut werden
+    const Point changed(options.breite / 3, options.hohe / 3);
+    grid.setCell(changed, grid.getCell(changed) == CellType::WALL ? CellType::EMPTY : CellType::WALL);
+    hpa.onLevelChanged();
+    const auto rebuildStart = Clock::now();
+    hpa.prepare(grid);
+    std::cout << "  Teil-Neubau nach einer Wandaenderung: " << micros(Clock::now() - rebuildStart) / 1000.0
+              << " ms, " << hpa.lastRebuiltClusters() << " von " << hpa.clusterCount() << " Clustern\n";
+
+    // Offenes Brett (nur Rand): hier wird die Front gross und die parallele BFS schaltet auf bottom-up
+    Grid open(options.breite, options.hohe, true);
+    bfsTime = parallelTime = Clock::duration{};
+    for (int q = 0; q < samples; q++) {
+        const Point start(distX(rng), distY(rng));
+        const Point goal(distX(rng), distY(rng));
+        const auto t0 = Clock::now();
+        const bool reachable = bfs.findPath(start, goal, open, snake, bfsPath);
+        const auto t1 = Clock::now();
+        const bool parallelFound = parallelBfs.findPath(start, goal, open, snake, parallelPath);
+        parallelTime += Clock::now() - t1;
+        bfsTime += t1 - t0;
+        if (parallelFound != reachable || parallelPath.size() != bfsPath.size()) {
+            parallelMismatches++;
+        }
+    }
+    std::cout << "  Offenes Brett: BFS " << micros(bfsTime) / samples << " us/Anfrage, parallele BFS "
+              << micros(parallelTime) / samples << " us/Anfrage (" << std::thread::hardware_concurrency()
+              << " Threads), Abweichungen gesamt: " << parallelMismatches << "\n";
+
+    return missed == 0 && parallelMismatches == 0 && slicedMismatches == 0 ? 0 : 1;
+}
+
+int Benchmark::runScenarios(const Options &options) {
+    using Clock = std::chrono::steady_clock;
+    const Pathfinder::Algorithm algorithms[] = {Pathfinder::Algorithm::BFS, Pathfinder::Algorithm::DIJKSTRA,
+                                                 Pathfinder::Algorithm::DISTANCE_FIELD, Pathfinder::Algorithm::HIERARCHICAL,
+                                                 Pathfinder::Algorithm::DSTAR_LITE, Pathfinder::Algorithm::PARALLEL_BFS};
+    constexpr size_t ALGORITHM_COUNT = sizeof(algorithms) / sizeof(algorithms[0]);
+
+    std::vector<MovingAI::Scenario> scenarios;
+    if (!MovingAI::loadScenarios(options.scenarioPath, scenarios)) {
+        return 1;
+    }
+    std::cout << "Szenarien: " << options.scenarioPath << ", " << scenarios.size() << " Anfragen\n";
+
+    struct Result {
+        Clock::duration time{};
+        size_t expanded = 0;
+        int queries = 0;
+        int found = 0;
+        int optimal = 0;            // so lang wie die 4er-BFS
+        double octileRatio = 0.0;   // Summe Pfadlaenge / Oktil-Optimum der Datei
+    };
+    Result results[ALGORITHM_COUNT];
+    PerfCounters counters[ALGORITHM_COUNT];
+    int skipped = 0;
+    int unreachable = 0;
+
+    Grid grid(1, 1, false);
+    BFSPathfinder reference;
+    std::vector<int> referenceLength;
+    std::vector<Point> path;
+    std::vector<Point> goal(1);
+
+    // Die Dateien sind nach Karte sortiert, jede Karte wird einmal geladen
+    for (size_t begin = 0; begin < scenarios.size();) {
+        size_t end = begin;
+        while (end < scenarios.size() && scenarios[end].map == scenarios[begin].map) end++;
+
+        const std::string mapPath = MovingAI::resolveMapPath(options.scenarioPath, scenarios[begin].map);
+        if (!MovingAI::loadMap(mapPath, grid)) {
+            return 1;
+        }
+        const int breite = grid.getBreite();
+        const int hohe = grid.getHohe();
+        path.reserve(static_cast<size_t>(breite) * hohe);
+        std::cout << "  Karte " << mapPath << ": " << breite << "x" << hohe << ", " << end - begin << " Anfragen\n";
+
+        // Die Pfadfinder brauchen eine Schlange: auf die erste Wand setzen, dort stoert sie nicht
+        Point parking(0, 0);
+        const CellType *cells = grid.data();
+        for (int i = 0; i < breite * hohe; i++) {
+            if (cells[i] == CellType::WALL) {
+                parking = Point(i % breite, i / breite);
+                break;
+            }
+        }
+        const Snake snake(parking, breite, hohe);
+
+        // Gueltige Szenarien und ihre 4er-Laenge (ohne Diagonalen) als Referenz
+        referenceLength.assign(end - begin, -1);
+        for (size_t i = begin; i < end; i++) {
+            const MovingAI::Scenario &s = scenarios[i];
+            const bool valid = s.mapBreite == breite && s.mapHohe == hohe
+                               && grid.isInBounds(s.start) && grid.isInBounds(s.goal)
+                               && grid.getCell(s.start) != CellType::WALL && grid.getCell(s.goal) != CellType::WALL
+                               && s.start != parking && s.goal != parking;
+            if (!valid) {
+                skipped++;
+                continue;
+            }
+            if (reference.findPath(s.start, s.goal, grid, snake, path)) {
+                referenceLength[i - begin] = static_cast<int>(path.size());
+            } else {
+                // Ohne Ecken schneiden ist alles mit Diagonalen Erreichbare auch ohne erreichbar
+                unreachable++;
+            }
+        }
+
+        for (size_t a = 0; a < ALGORITHM_COUNT; a++) {
+            std::unique_ptr<Pathfinder> pathfinder = Pathfinder::create(algorithms[a]);
+            pathfinder->onLevelChanged();
+            // Erste Anfrage ungemessen: Puffer anlegen, HPA* baut seine Cluster
+            goal[0] = scenarios[begin].goal;
+            pathfinder->onFoodChanged(goal);
+            pathfinder->findPath(scenarios[begin].start, scenarios[begin].goal, grid, snake, path);
+            pathfinder->takeNodesExpanded();
+
+            Result &r = results[a];
+            for (size_t i = begin; i < end; i++) {
+                if (referenceLength[i - begin] < 0) continue;
+                const MovingAI::Scenario &s = scenarios[i];
+                // Distanzfeld und D* Lite planen zum Essen: das Ziel ist das einzige Essen
+                goal[0] = s.goal;
+                pathfinder->onFoodChanged(goal);
+                counters[a].start();
+                const auto start = Clock::now();
+                const bool found = pathfinder->findPath(s.start, s.goal, grid, snake, path);
+                r.time += Clock::now() - start;
+                counters[a].stop();
+                r.expanded += pathfinder->takeNodesExpanded();
+                r.queries++;
+                if (!found) continue;
+                r.found++;
+                if (static_cast<int>(path.size()) == referenceLength[i - begin]) r.optimal++;
+                if (s.optimal > 0.0) r.octileRatio += static_cast<double>(path.size()) / s.optimal;
+            }
+        }
+        begin = end;
+    }
+
+    for (size_t a = 0; a < ALGORITHM_COUNT; a++) {
+        const Result &r = results[a];
+        const int n = std::max(1, r.queries);
+        std::cout << "  " << algorithmName(algorithms[a]) << ": "
+                  << std::chrono::duration<double, std::micro>(r.time).count() / n << " us/Anfrage, "
+                  << r.expanded / static_cast<size_t>(n) << " Knoten/Anfrage, gefunden " << r.found << "/" << r.queries
+                  << ", optimal (4er) " << r.optimal << "/" << r.queries
+                  << ", Laenge/Oktil-Optimum " << (r.found > 0 ? r.octileRatio / r.found : 0.0) << "\n";
+        if (counters[a].available()) {
+            std::cout << "    Zaehler: ";
+            counters[a].print(std::cout, n, "Anfrage");
+            std::cout << "\n";
+        }
+    }
+    if (!counters[0].available()) {
+        std::cout << "  Hardware-Zaehler nicht verfuegbar: " << counters[0].unavailableReason() << "\n";
+    }
+    if (skipped > 0) {
+        std::cout << "  " << skipped << " Szenarien uebersprungen (Kartengroesse, Wand oder Parkplatz der Schlange)\n";
+    }
+    if (unreachable > 0) {
+        std::cout << "FEHLER: " << unreachable << " Szenarien ohne Diagonalen unerreichbar\n";
+    }
+    return unreachable == 0 ? 0 : 1;
+}
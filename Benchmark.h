@@ -0,0 +1,51 @@
+#ifndef SNAKEGAME_BENCHMARK_H
+#define SNAKEGAME_BENCHMARK_H
+
+#include "Pathfinder.h"
+#include <cstddef>
+#include <string>
+
+// Headless-Benchmark: laesst AutoPlay ohne SDL-Fenster laufen und misst pro Algorithmus
+// die Zeit pro Tick und die Heap-Allokationen im eingeschwungenen Zustand.
+class Benchmark {
+public:
+    struct Options {
+        int ticks = 20000;          // gemessene Ticks pro Algorithmus
+        int warmupTicks = 500;      // Ticks zum Aufwaermen der Puffer (nicht gemessen)
+        int breite = 40;
+        int hohe = 30;
+        int foodItems = 0;          // > 0: so viele Essen gleichzeitig (Stresstest fuer den Essen-Index)
+        std::string recordPath;     // nicht leer: jede Partie aufzeichnen (<pfad>.<algorithmus>)
+        std::string resumePath;     // nicht leer: jede Partie ab diesem Snapshot starten
+        std::string scenarioPath;   // nicht leer: MovingAI-Szenarien (.scen) statt Partien
+        std::string videoPath;      // nicht leer: jeden Tick als Video (<pfad>.<algorithmus>.y4m/.ppm)
+        int videoCellSize = 8;      // Pixel pro Zelle im Video
+        size_t searchNodeBudget = 0;    // > 0: Suche in Zeitscheiben, so viele Knoten pro Tick
+        int searchMicrosBudget = 0;     // > 0: dito, Mikrosekunden pro Tick
+        bool speculate = false;         // naechsten Pfad im Hintergrund planen (SpeculativePlanner)
+    };
+
+    // Rueckgabe als Exit-Code: 0 = alles ok, 1 = Allokationen im eingeschwungenen Tick gefunden
+    // oder der MoveSafety-Selbsttest (Ausweichzug senkrecht zur Laufrichtung) schlaegt fehl
+    static int run(const Options &options);
+
+    // Grosse Grids (--grid=WxH): einzelne Pfadanfragen quer ueber ein Labyrinth, HPA* und parallele
+    // BFS gegen BFS, die parallele BFS zusaetzlich auf einem offenen Brett.
+    // Prueft ausserdem den Teil-Neubau nach einer lokalen Wandaenderung.
+    // Dazu die Zeitscheiben-Suche mit --budget (Standard 4096 Knoten) gegen BFS.
+    // Rueckgabe: 0 = ok, 1 = HPA* hat einen erreichbaren Weg nicht gefunden oder parallele BFS/Zeitscheiben weichen ab
+    static int runQueries(const Options &options, int queries = 200);
+
+    // MovingAI-Szenarien (--scen=datei.scen): jede Anfrage durch jeden Pfadfinder, mit Knoten und
+    // Zeit pro Anfrage. Optimal heisst hier: so lang wie die 4er-BFS, die Datei kennt nur die
+    // Laenge mit Diagonalen (ausgegeben wird das Verhaeltnis dazu).
+    // Rueckgabe: 0 = ok, 1 = Datei/Karte nicht lesbar oder ein Szenario ist ohne Diagonalen unerreichbar
+    static int runScenarios(const Options &options);
+
+    // Anzahl aller bisherigen operator-new-Aufrufe im Prozess. Den zaehlenden operator new gibt es
+    // nur im Target SnakeBenchmark (AllocationCounter.cpp), im Spiel ist der Wert immer 0
+    static size_t allocationCount();
+    [[nodiscard]] static bool countsAllocations();
+};
+
+#endif //SNAKEGAME_BENCHMARK_H
@@ -0,0 +1,137 @@
+#include "ClearanceMap.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SNAKEGAME_CLEARANCE_SSE2 1
+#endif
+
+namespace {
+    constexpr uint8_t CAP = ClearanceMap::CAP;
+
+    // dst[i] = min(dst[i], src[i] + 1) fuer eine Zeile (senkrechter Durchgang)
+    void relaxFrom(uint8_t *dst, const uint8_t *src, int count) {
+        int x = 0;
+#ifdef SNAKEGAME_CLEARANCE_SSE2
+        const __m128i one = _mm_set1_epi8(1);
+        for (; x + 16 <= count; x += 16) {
+            const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x));
+            const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + x));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), _mm_min_epu8(d, _mm_adds_epu8(s, one)));
+        }
+#endif
+        for (; x < count; x++) {
+            dst[x] = std::min<uint8_t>(dst[x], src[x] + 1);
+        }
+    }
+
+    // row[i] = min(row[i], row[i-1] + 1, row[i+1] + 1), in place. Gemischt alte/neue Nachbarwerte
+    // zu lesen ist hier egal: die Werte fallen nur und nie unter den echten Abstand.
+    void relaxSideways(uint8_t *row, int count) {
+        int x = 0;
+#ifdef SNAKEGAME_CLEARANCE_SSE2
+        const __m128i one = _mm_set1_epi8(1);
+        for (; x + 16 <= count; x += 16) {
+            const __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + x - 1));
+            const __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + x + 1));
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + x));
+            const __m128i n = _mm_min_epu8(_mm_adds_epu8(l, one), _mm_adds_epu8(r, one));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(row + x), _mm_min_epu8(c, n));
+        }
+#endif
+        for (; x < count; x++) {
+            const uint8_t n = std::min(row[x - 1], row[x + 1]) + 1;
+            row[x] = std::min(row[x], n);
+        }
+    }
+
+    // Freiraum uebernehmen und Kosten 1 + (CAP - Freiraum) daraus ableiten
+    void storeRow(uint8_t *clearance, uint8_t *cost, const uint8_t *src, int count) {
+        int x = 0;
+#ifdef SNAKEGAME_CLEARANCE_SSE2
+        const __m128i one = _mm_set1_epi8(1);
+        const __m128i cap = _mm_set1_epi8(static_cast<char>(CAP));
+        for (; x + 16 <= count; x += 16) {
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(clearance + x), c);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(cost + x), _mm_adds_epu8(_mm_subs_epu8(cap, c), one));
+        }
+#endif
+        for (; x < count; x++) {
+            clearance[x] = src[x];
+            cost[x] = 1 + (CAP - src[x]);
+        }
+    }
+}
+
+void ClearanceMap::build(const Grid &grid, const Snake &snake) {
+    breite = grid.getBreite();
+    hohe = grid.getHohe();
+    const size_t cells = static_cast<size_t>(breite) * hohe;
+    clearance.resize(cells);
+    cost.resize(cells);
+    // Gleich fuer das ganze Grid anlegen, die Fenster pro Tick passen dann immer hinein
+    work.resize(static_cast<size_t>(breite + 2 * PAD) * hohe);
+    transform(grid, snake, 0, 0, breite, hohe, 0, 0, breite, hohe);
+    valid = true;
+}
+
+void ClearanceMap::update(const Grid &grid, const Snake &snake, int index) {
+    if (index < 0 || index >= breite * hohe) {
+        return;
+    }
+    const int x = index % breite;
+    const int y = index / breite;
+    // Ab Abstand CAP ist der Wert gekappt, betroffen ist also nur |dx|, |dy| < CAP ...
+    const int ix0 = std::max(0, x - CAP + 1);
+    const int iy0 = std::max(0, y - CAP + 1);
+    const int ix1 = std::min(breite, x + CAP);
+    const int iy1 = std::min(hohe, y + CAP);
+    // ... und deren naechstes Hindernis liegt hoechstens CAP weiter weg
+    transform(grid, snake, std::max(0, ix0 - CAP), std::max(0, iy0 - CAP),
+              std::min(breite, ix1 + CAP), std::min(hohe, iy1 + CAP), ix0, iy0, ix1, iy1);
+}
+
+void ClearanceMap::transform(const Grid &grid, const Snake &snake, int x0, int y0, int x1, int y1,
+                             int ix0, int iy0, int ix1, int iy1) {
+    const int w = x1 - x0;
+    const int h = y1 - y0;
+    const int stride = w + 2 * PAD;
+    const CellType *cells = grid.data();
+
+    // Startwerte: Hindernis 0, sonst CAP; der Rand zaehlt als frei
+    for (int y = 0; y < h; y++) {
+        uint8_t *row = work.data() + static_cast<size_t>(y) * stride;
+        std::fill(row, row + PAD, CAP);
+        std::fill(row + PAD + w, row + stride, CAP);
+        const int base = (y0 + y) * breite + x0;
+        for (int x = 0; x < w; x++) {
+            const int i = base + x;
+            row[PAD + x] = (cells[i] == CellType::WALL || snake.countAtIndex(i) != 0) ? 0 : CAP;
+        }
+    }
+
+    // Senkrecht: von oben nach unten, dann zurueck
+    for (int y = 1; y < h; y++) {
+        uint8_t *row = work.data() + static_cast<size_t>(y) * stride;
+        relaxFrom(row + PAD, row + PAD - stride, w);
+    }
+    for (int y = h - 2; y >= 0; y--) {
+        uint8_t *row = work.data() + static_cast<size_t>(y) * stride;
+        relaxFrom(row + PAD, row + PAD + stride, w);
+    }
+
+    // Waagrecht: nach CAP Runden hat jede Zelle ihr Minimum aus der Zeile gesehen
+    for (int y = 0; y < h; y++) {
+        uint8_t *row = work.data() + static_cast<size_t>(y) * stride + PAD;
+        for (int round = 0; round < CAP; round++) {
+            relaxSideways(row, w);
+        }
+    }
+
+    for (int y = iy0; y < iy1; y++) {
+        const uint8_t *src = work.data() + static_cast<size_t>(y - y0) * stride + PAD + (ix0 - x0);
+        const size_t dst = static_cast<size_t>(y) * breite + ix0;
+        storeRow(clearance.data() + dst, cost.data() + dst, src, ix1 - ix0);
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef SNAKEGAME_CLEARANCEMAP_H
+#define SNAKEGAME_CLEARANCEMAP_H
+
+#include "Snake.h"
+#include <vector>
+#include <cstdint>
+
+// Freiraum-Karte: pro Zelle der L1-Abstand zur naechsten Wand- oder Body-Zelle, gekappt bei CAP.
+// Daraus entsteht eine Kostenschicht fuer Dijkstra: enge Gaenge und Zellen direkt am Body werden
+// teurer, damit der Weg zum Essen lieber durch offenes Gelaende fuehrt.
+// Gerechnet wird als Distanztransformation in zwei Durchgaengen (erst senkrecht Zeile fuer Zeile,
+// dann CAP waagrechte Relaxierungen), beide ueber 16 Zellen auf einmal mit SSE2 (sonst skalar).
+// Pro Zug aendern sich nur Kopf und Schwanz, neu gerechnet wird dann nur ein Fenster um die beiden.
+class ClearanceMap {
+public:
+    // Weiter weg zaehlt nicht mehr als "frei"
+    static constexpr int CAP = 3;
+
+    // Komplett neu aufbauen, O(Zellen)
+    void build(const Grid &grid, const Snake &snake);
+    // Nach einer Belegungsaenderung an index nur die Umgebung (Radius CAP) neu rechnen
+    void update(const Grid &grid, const Snake &snake, int index);
+    void invalidate() { valid = false; }
+    [[nodiscard]] bool isValid() const { return valid; }
+    [[nodiscard]] int getBreite() const { return breite; }
+    [[nodiscard]] int getHohe() const { return hohe; }
+
+    // 0 = Wand/Body, 1 = direkt daneben, ..., CAP = frei genug
+    [[nodiscard]] int clearanceAt(int index) const { return clearance[index]; }
+    // Schrittkosten beim Betreten einer Zelle: 1 + (CAP - Freiraum), flach fuer den Dijkstra-Kern
+    [[nodiscard]] const uint8_t *costs() const { return cost.data(); }
+
+private:
+    // Rand links/rechts im Arbeitspuffer, damit die verschobenen Loads nie aus der Zeile fallen
+    static constexpr int PAD = 16;
+
+    int breite = 0;
+    int hohe = 0;
+    bool valid = false;
+    std::vector<uint8_t> clearance;
+    std::vector<uint8_t> cost;
+    std::vector<uint8_t> work;      // Arbeitspuffer fuer ein Rechteck, Zeilen mit PAD Rand
+
+    // Transformiert das Rechteck [x0, x1) x [y0, y1) und uebernimmt davon nur das innere
+    // Rechteck [ix0, ix1) x [iy0, iy1) (der Rest ist nur Kontext fuer die Raender)
+    void transform(const Grid &grid, const Snake &snake, int x0, int y0, int x1, int y1,
+                   int ix0, int iy0, int ix1, int iy1);
+};
+
+#endif //SNAKEGAME_CLEARANCEMAP_H
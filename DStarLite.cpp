@@ -0,0 +1,271 @@
+#include "DStarLite.h"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+namespace {
+    const auto heapOrder = std::greater<std::pair<int64_t, int>>();
+}
+
+int64_t DStarLitePathfinder::key(int cell, int start) const {
+    // [min(g, rhs) + h(Start, Zelle) + km ; min(g, rhs)], lexikografisch in einem int64
+    const int base = std::min(g[cell], rhs[cell]);
+    return (static_cast<int64_t>(base + heuristic(start, cell) + km) << 32) | base;
+}
+
+void DStarLitePathfinder::push(int cell, int64_t k) {
+    if (heap.size() == heap.capacity()) {
+        // Zu viele veraltete Eintraege: nur die gueltigen behalten (O(Zellen), passiert selten)
+        heap.clear();
+        for (int i = 0; i < static_cast<int>(openKey.size()); i++) {
+            if (openKey[i] != NOT_OPEN) heap.emplace_back(openKey[i], i);
+        }
+        std::make_heap(heap.begin(), heap.end(), heapOrder);
+    }
+    openKey[cell] = k;
+    heap.emplace_back(k, cell);
+    std::push_heap(heap.begin(), heap.end(), heapOrder);
+}
+
+void DStarLitePathfinder::initialize(const Grid &grid, const Snake &snake, int start) {
+    breite = grid.getBreite();
+    hohe = grid.getHohe();
+    const size_t cells = static_cast<size_t>(breite) * hohe;
+    g.assign(cells, INF);
+    rhs.assign(cells, INF);
+    isGoal.assign(cells, 0);
+    openKey.assign(cells, NOT_OPEN);
+    blocked.resize(cells);
+    const CellType *data = grid.data();
+    for (int i = 0; i < static_cast<int>(cells); i++) {
+        blocked[i] = i != start && (data[i] == CellType::WALL || snake.blocksIndex(i));
+    }
+    heap.clear();
+    heap.reserve(cells * 2 + 64);
+    goals.clear();
+    goals.reserve(cells);
+    // Puffer der BFS fuer die Schwanz-Suche gleich mit anlegen, sonst allokiert der erste Tick damit
+    scratch.begin(breite, hohe);
+    foodsChanged = true;
+
+    const Snake::MoveDelta &delta = snake.getLastMove();
+    trackedSnake = &snake;
+    seenMoves = delta.moveCount;
+    seenEpoch = delta.epoch;
+    lastStart = start;
+    lastTail = snake.getTailIndex();
+    km = 0;
+    initialized = true;
+}
+
+void DStarLitePathfinder::onFoodChanged(const std::vector<Point> &foodPositions) {
+    foods.assign(foodPositions.begin(), foodPositions.end());
+    foodsChanged = true;
+}
+
+template<class GridPolicy>
+void DStarLitePathfinder::syncFood(const GridPolicy &policy, const CellType *cells, int start) {
+    if (!foodsChanged) {
+        return;
+    }
+    foodsChanged = false;
+    // 2 = war Ziel, noch nicht bestaetigt
+    for (int cell : goals) isGoal[cell] = 2;
+    for (const Point &food : foods) {
+        if (food.x < 0 || food.x >= breite || food.y < 0 || food.y >= hohe) continue;
+        const int cell = food.y * breite + food.x;
+        const bool added = isGoal[cell] == 0;
+        isGoal[cell] = 1;
+        if (added) updateVertex(policy, cells, cell, start);
+    }
+    for (int cell : goals) {
+        if (isGoal[cell] == 2) {
+            isGoal[cell] = 0;
+            updateVertex(policy, cells, cell, start);
+        }
+    }
+    goals.clear();
+    for (const Point &food : foods) {
+        if (food.x < 0 || food.x >= breite || food.y < 0 || food.y >= hohe) continue;
+        goals.push_back(food.y * breite + food.x);
+    }
+}
+
+template<class GridPolicy>
+void DStarLitePathfinder::syncSnake(const GridPolicy &policy, const CellType *cells, const Snake &snake, int start) {
+    const Snake::MoveDelta &delta = snake.getLastMove();
+    if (start != lastStart) {
+        km += heuristic(lastStart, start);
+    }
+    const bool incremental = &snake == trackedSnake && delta.epoch == seenEpoch && delta.moveCount - seenMoves <= 1;
+    if (incremental) {
+        // Alter Kopf wird Body, neuer Kopf ist Start, neuer Schwanz wird frei
+        refresh(policy, cells, snake, start, lastStart);
+        refresh(policy, cells, snake, start, start);
+        refresh(policy, cells, snake, start, lastTail);
+        refresh(policy, cells, snake, start, snake.getTailIndex());
+        if (delta.moveCount != seenMoves) {
+            refresh(policy, cells, snake, start, delta.enteredIndex);
+            refresh(policy, cells, snake, start, delta.vacatedIndex);
+        }
+    } else {
+        // Mehrere Zuege verpasst, Respawn oder Restore: alles vergleichen, repariert wird trotzdem
+        // nur, wo sich die Belegung geaendert hat
+        const int count = breite * hohe;
+        for (int cell = 0; cell < count; cell++) {
+            refresh(policy, cells, snake, start, cell);
+        }
+    }
+    trackedSnake = &snake;
+    seenMoves = delta.moveCount;
+    seenEpoch = delta.epoch;
+    lastStart = start;
+    lastTail = snake.getTailIndex();
+}
+
+template<class GridPolicy>
+void DStarLitePathfinder::refresh(const GridPolicy &policy, const CellType *cells, const Snake &snake, int start, int cell) {
+    if (cell < 0 || cells[cell] == CellType::WALL) {
+        return;
+    }
+    const uint8_t now = cell != start && snake.blocksIndex(cell);
+    if (now == blocked[cell]) {
+        return;
+    }
+    blocked[cell] = now;
+    updateVertex(policy, cells, cell, start);
+    SearchKernels::expand(policy, cells, Occupancy{blocked.data()}, cell, [&](int neighbor) {
+        updateVertex(policy, cells, neighbor, start);
+    });
+}
+
+template<class GridPolicy>
+void DStarLitePathfinder::updateVertex(const GridPolicy &policy, const CellType *cells, int cell, int start) {
+    if (blocked[cell]) {
+        rhs[cell] = INF;
+    } else if (isGoal[cell]) {
+        rhs[cell] = 0;
+    } else {
+        int best = INF;
+        SearchKernels::expand(policy, cells, Occupancy{blocked.data()}, cell, [&](int neighbor) {
+            best = std::min(best, g[neighbor] + 1);
+        });
+        rhs[cell] = std::min(best, INF);
+    }
+    if (g[cell] != rhs[cell]) {
+        push(cell, key(cell, start));
+    } else {
+        openKey[cell] = NOT_OPEN;
+    }
+}
+
+template<class GridPolicy>
+void DStarLitePathfinder::computeShortestPath(const GridPolicy &policy, const CellType *cells, int start) {
+    while (true) {
+        // Veraltete Eintraege oben verwerfen
+        while (!heap.empty() && openKey[heap.front().second] != heap.front().first) {
+            std::pop_heap(heap.begin(), heap.end(), heapOrder);
+            heap.pop_back();
+        }
+        if (heap.empty()) {
+            return;
+        }
+        const auto [oldKey, u] = heap.front();
+        if (oldKey >= key(start, start) && rhs[start] == g[start]) {
+            return;
+        }
+        std::pop_heap(heap.begin(), heap.end(), heapOrder);
+        heap.pop_back();
+        openKey[u] = NOT_OPEN;
+        scratch.expanded++;
+
+        const int64_t newKey = key(u, start);
+        if (oldKey < newKey) {
+            // Schluessel durch km veraltet: mit dem aktuellen wieder einreihen
+            push(u, newKey);
+        } else if (g[u] > rhs[u]) {
+            g[u] = rhs[u];
+            SearchKernels::expand(policy, cells, Occupancy{blocked.data()}, u, [&](int neighbor) {
+                updateVertex(policy, cells, neighbor, start);
+            });
+        } else {
+            g[u] = INF;
+            updateVertex(policy, cells, u, start);
+            SearchKernels::expand(policy, cells, Occupancy{blocked.data()}, u, [&](int neighbor) {
+                updateVertex(policy, cells, neighbor, start);
+            });
+        }
+    }
+}
+
+template<class GridPolicy>
+bool DStarLitePathfinder::extractPath(const GridPolicy &policy, const CellType *cells, int start, std::vector<Point> &out) const {
+    int current = start;
+    int remaining = rhs[start];
+    while (!isGoal[current]) {
+        int next = -1;
+        SearchKernels::expand(policy, cells, Occupancy{blocked.data()}, current, [&](int neighbor) {
+            if (next < 0 || g[neighbor] < g[next]) next = neighbor;
+        });
+        if (next < 0 || g[next] >= remaining) {
+            return false;
+        }
+        remaining = g[next];
+        out.emplace_back(next % breite, next / breite);
+        current = next;
+    }
+    return true;
+}
+
+template<typename Body>
+bool DStarLitePathfinder::fallback(Point start, Point goal, const Grid &grid, const Body &snake, std::vector<Point> &out) {
+    const int w = grid.getBreite();
+    return SearchKernels::withGridPolicy(grid, start, [&](const auto &policy) {
+        return SearchKernels::bfs(policy, grid.data(), snake, start.y * w + start.x, goal.y * w + goal.x, scratch, out);
+    });
+}
+
+bool DStarLitePathfinder::findPath(Point start, Point goal, const Grid &grid, const Snake &snake, std::vector<Point> &out) {
+    out.clear();
+    if (!grid.isInBounds(start) || !grid.isInBounds(goal)) {
+        return false;
+    }
+    const int startIndex = start.y * grid.getBreite() + start.x;
+    const int goalIndex = goal.y * grid.getBreite() + goal.x;
+    if (!initialized || grid.getBreite() != breite || grid.getHohe() != hohe) {
+        initialize(grid, snake, startIndex);
+    }
+
+    bool responsible = false;
+    const bool found = SearchKernels::withGridPolicy(grid, start, [&](const auto &policy) {
+        syncFood(policy, grid.data(), startIndex);
+        syncSnake(policy, grid.data(), snake, startIndex);
+        // Nur Wege zum Essen, alles andere (z.B. Schwanz) sucht normal
+        if (!isGoal[goalIndex] || blocked[goalIndex]) {
+            return false;
+        }
+        responsible = true;
+        if (startIndex == goalIndex) {
+            return true;
+        }
+        computeShortestPath(policy, grid.data(), startIndex);
+        if (rhs[startIndex] >= INF) {
+            return false;
+        }
+        if (!extractPath(policy, grid.data(), startIndex, out)) {
+            out.clear();
+            responsible = false;
+            return false;
+        }
+        return true;
+    });
+    return responsible ? found : fallback(start, goal, grid, snake, out);
+}
+
+bool DStarLitePathfinder::findPath(Point start, Point goal, const Grid &grid, const VirtualSnake &snake, std::vector<Point> &out) {
+    out.clear();
+    if (!grid.isInBounds(start) || !grid.isInBounds(goal)) {
+        return false;
+    }
+    return fallback(start, goal, grid, snake, out);
+}
@@ -0,0 +1,84 @@
+#ifndef SNAKEGAME_DSTARLITE_H
+#define SNAKEGAME_DSTARLITE_H
+
+#include "Pathfinder.h"
+#include <vector>
+#include <limits>
+
+// D* Lite mit allen Essen als Wurzel: g/rhs sind Schritte zum naechsten Essen, die Suche laeuft
+// rueckwaerts zum Kopf und behaelt ihren Zustand ueber die Ticks. Pro Tick aendern sich nur
+// wenige Zellen (alter Kopf wird Body, neuer Schwanz wird frei, beim Fressen ein Essen), die
+// kommen aus Snake::getLastMove() und onFoodChanged(); repariert wird nur, was davon abhaengt.
+// Wie beim Distanzfeld fuehrt der Pfad zum naechsten Essen, goal entscheidet nur, ob der Planer
+// zustaendig ist. Suchen zu anderen Zielen und auf VirtualSnake laufen ueber die normale BFS.
+class DStarLitePathfinder : public Pathfinder {
+public:
+    using Pathfinder::findPath;
+    bool findPath(Point start, Point goal, const Grid &grid, const Snake &snake, std::vector<Point> &out) override;
+    bool findPath(Point start, Point goal, const Grid &grid, const VirtualSnake &snake, std::vector<Point> &out) override;
+
+    void onFoodChanged(const std::vector<Point> &foodPositions) override;
+    void onLevelChanged() override { initialized = false; }
+
+private:
+    static constexpr int INF = std::numeric_limits<int>::max() / 4;
+    static constexpr int64_t NOT_OPEN = -1;
+
+    int breite = 0;
+    int hohe = 0;
+    bool initialized = false;
+
+    std::vector<int> g;
+    std::vector<int> rhs;
+    std::vector<uint8_t> blocked;       // Belegung, mit der g/rhs gerechnet sind (Wand oder Body)
+    std::vector<uint8_t> isGoal;
+    std::vector<int64_t> openKey;       // aktueller Schluessel in der Open-List, NOT_OPEN = nicht drin
+    std::vector<std::pair<int64_t, int>> heap;     // Min-Heap (Schluessel, Zelle), veraltete Eintraege werden uebersprungen
+
+    // Essen: gemeldet (foods) und im Planer eingetragen (goals)
+    std::vector<Point> foods;
+    std::vector<int> goals;
+    bool foodsChanged = false;
+
+    // Stand der Schlange beim letzten Aufruf
+    const Snake *trackedSnake = nullptr;
+    uint64_t seenMoves = 0;
+    uint32_t seenEpoch = 0;
+    int lastStart = -1;
+    int lastTail = -1;
+    int km = 0;                         // Summe der Kopfbewegungen (Heuristik-Offset von D* Lite)
+
+    // Blockierend: Wand oder Body, der Start selbst ist immer frei
+    struct Occupancy {
+        const uint8_t *blocked;
+        [[nodiscard]] bool blocksIndex(int index) const { return blocked[index] != 0; }
+    };
+
+    [[nodiscard]] int heuristic(int a, int b) const {
+        return std::abs(a % breite - b % breite) + std::abs(a / breite - b / breite);
+    }
+    [[nodiscard]] int64_t key(int cell, int start) const;
+
+    void initialize(const Grid &grid, const Snake &snake, int start);
+    void push(int cell, int64_t k);
+
+    template<class GridPolicy>
+    void syncFood(const GridPolicy &policy, const CellType *cells, int start);
+    template<class GridPolicy>
+    void syncSnake(const GridPolicy &policy, const CellType *cells, const Snake &snake, int start);
+    // Belegung einer Zelle neu pruefen, bei Aenderung sie und ihre Nachbarn reparieren
+    template<class GridPolicy>
+    void refresh(const GridPolicy &policy, const CellType *cells, const Snake &snake, int start, int cell);
+    template<class GridPolicy>
+    void updateVertex(const GridPolicy &policy, const CellType *cells, int cell, int start);
+    template<class GridPolicy>
+    void computeShortestPath(const GridPolicy &policy, const CellType *cells, int start);
+    // Vom Start aus immer zum Nachbarn mit kleinstem g; false wenn g dort nicht stimmig ist
+    template<class GridPolicy>
+    bool extractPath(const GridPolicy &policy, const CellType *cells, int start, std::vector<Point> &out) const;
+
+    template<typename Body>
+    bool fallback(Point start, Point goal, const Grid &grid, const Body &snake, std::vector<Point> &out);
+};
+
+#endif //SNAKEGAME_DSTARLITE_H
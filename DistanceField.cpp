@@ -0,0 +1,157 @@
+#include "DistanceField.h"
+
+int DistanceField::build(const Grid &grid, const std::vector<Point> &sources) {
+    if (grid.getBreite() != breite || grid.getHohe() != hohe) {
+        breite = grid.getBreite();
+        hohe = grid.getHohe();
+        field.assign(static_cast<size_t>(breite) * hohe, UNREACHABLE);
+        queue.assign(static_cast<size_t>(breite) * hohe, 0);
+    } else {
+        std::fill(field.begin(), field.end(), UNREACHABLE);
+    }
+    valid = true;
+
+    // Alle Essen gleichzeitig als Start (Entfernung 0)
+    int read = 0;
+    int write = 0;
+    for (const Point &food : sources) {
+        if (!grid.isInBounds(food) || grid.getCell(food) == CellType::WALL) continue;
+        const int index = food.y * breite + food.x;
+        if (field[index] == 0) continue;
+        field[index] = 0;
+        queue[write++] = index;
+    }
+    if (write == 0) {
+        return 0;
+    }
+
+    // Nur Nicht-Wand-Zellen landen in der Queue, mit Rand liegen die also alle im Inneren
+    SearchKernels::withGridPolicy(grid, Point(queue[0] % breite, queue[0] / breite), [&](const auto &policy) {
+        while (read < write) {
+            const int current = queue[read++];
+            const int next = field[current] + 1;
+            SearchKernels::expand(policy, grid.data(), NoOccupancy{}, current, [&](int neighbor) {
+                if (field[neighbor] == UNREACHABLE) {
+                    field[neighbor] = next;
+                    queue[write++] = neighbor;
+                }
+            });
+        }
+    });
+    return write;
+}
+
+void DistanceFieldPathfinder::onFoodChanged(const std::vector<Point> &foodPositions) {
+    sources.assign(foodPositions.begin(), foodPositions.end());
+    sourcesKnown = true;
+    field.invalidate();
+}
+
+bool DistanceFieldPathfinder::findPath(Point start, Point goal, const Grid &grid, const Snake &snake, std::vector<Point> &out) {
+    return steer(start, goal, grid, snake, out);
+}
+
+bool DistanceFieldPathfinder::findPath(Point start, Point goal, const Grid &grid, const VirtualSnake &snake, std::vector<Point> &out) {
+    return steer(start, goal, grid, snake, out);
+}
+
+template<typename Body>
+bool DistanceFieldPathfinder::fallback(Point start, Point goal, const Grid &grid, const Body &snake, std::vector<Point> &out) {
+    const int breite = grid.getBreite();
+    return SearchKernels::withGridPolicy(grid, start, [&](const auto &policy) {
+        return SearchKernels::bfs(policy, grid.data(), snake,
+                                  start.y * breite + start.x, goal.y * breite + goal.x, scratch, out);
+    });
+}
+
+template<typename Body>
+bool DistanceFieldPathfinder::steer(Point start, Point goal, const Grid &grid, const Body &snake, std::vector<Point> &out) {
+    out.clear();
+    if (!grid.isInBounds(start) || !grid.isInBounds(goal)) {
+        return false;
+    }
+    if (!sourcesKnown) {
+        return fallback(start, goal, grid, snake, out);
+    }
+    if (!field.isValid()) {
+        scratch.expanded += field.build(grid, sources);
+    }
+    // Das Feld fuehrt nur zum Essen, alles andere (z.B. Schwanz) sucht normal
+    if (field.at(goal) != 0) {
+        return fallback(start, goal, grid, snake, out);
+    }
+
+    const int breite = grid.getBreite();
+    const int startIndex = start.y * breite + start.x;
+    if (startIndex == goal.y * breite + goal.x) {
+        return true;
+    }
+
+    const bool steered = SearchKernels::withGridPolicy(grid, start, [&](const auto &policy) {
+        scratch.begin(breite, grid.getHohe());
+
+        // Lokale Reparatur: begrenzte BFS um den Kopf, hier zaehlt der Body
+        int read = 0;
+        int write = 0;
+        scratch.queue[write++] = startIndex;
+        scratch.markVisited(startIndex);
+        scratch.distance[startIndex] = 0;
+
+        int best = -1;
+        int bestCost = DistanceField::UNREACHABLE;
+        while (read < write && read < LOCAL_REPAIR_CELLS) {
+            const int current = scratch.queue[read++];
+            scratch.expanded++;
+            const int remaining = field.at(current);
+            if (current != startIndex && remaining != DistanceField::UNREACHABLE) {
+                // Essen im Fenster: in BFS-Reihenfolge ist das der kuerzeste echte Weg
+                if (remaining == 0) {
+                    best = current;
+                    break;
+                }
+                const int cost = scratch.distance[current] + remaining;
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    best = current;
+                }
+            }
+
+            SearchKernels::expand(policy, grid.data(), snake, current, [&](int neighbor) {
+                if (!scratch.isVisited(neighbor)) {
+                    scratch.markVisited(neighbor);
+                    scratch.cameFrom[neighbor] = current;
+                    scratch.distance[neighbor] = scratch.distance[current] + 1;
+                    scratch.queue[write++] = neighbor;
+                }
+            });
+        }
+        if (best < 0) {
+            return false;
+        }
+        scratch.buildPath(startIndex, best, out);
+
+        // Ab dem Fenster bergab im Feld, freie Zellen bevorzugen.
+        // Fuehrt jeder kuerzeste Weg durch den Body, lohnt sich die Abkuerzung nicht
+        int current = best;
+        while (field.at(current) > 0) {
+            const int wanted = field.at(current) - 1;
+            int next = -1;
+            bool nextBlocked = true;
+            SearchKernels::expand(policy, grid.data(), NoOccupancy{}, current, [&](int neighbor) {
+                if (field.at(neighbor) != wanted) return;
+                const bool blocked = snake.blocksIndex(neighbor);
+                if (next < 0 || (nextBlocked && !blocked)) {
+                    next = neighbor;
+                    nextBlocked = blocked;
+                }
+            });
+            if (nextBlocked) {
+                return false;
+            }
+            out.emplace_back(next % breite, next / breite);
+            current = next;
+        }
+        return true;
+    });
+    return steered || fallback(start, goal, grid, snake, out);
+}
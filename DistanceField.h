@@ -0,0 +1,63 @@
+#ifndef SNAKEGAME_DISTANCEFIELD_H
+#define SNAKEGAME_DISTANCEFIELD_H
+
+#include "Pathfinder.h"
+#include <vector>
+#include <limits>
+
+// Entfernungsfeld: rueckwaerts gerichtete Multi-Source-BFS von allen Essen aus ueber die
+// statischen Waende (die Schlange wird ignoriert). Jede Zelle kennt danach ihre Schrittzahl
+// zum naechsten Essen. Neu gebaut wird nur, wenn sich Essen oder Level aendern.
+class DistanceField {
+private:
+    int breite = 0;
+    int hohe = 0;
+    std::vector<int> field;
+    std::vector<int> queue;
+    bool valid = false;
+
+public:
+    static constexpr int UNREACHABLE = std::numeric_limits<int>::max();
+
+    // Baut das Feld fuer die gegebenen Quellen (Essen) neu auf, O(Zellen).
+    // Rueckgabe: Anzahl erreichter Zellen
+    int build(const Grid &grid, const std::vector<Point> &sources);
+    void invalidate() { valid = false; }
+    [[nodiscard]] bool isValid() const { return valid; }
+
+    // Schritte bis zum naechsten Essen, UNREACHABLE wenn keins erreichbar ist
+    [[nodiscard]] int at(int index) const { return field[index]; }
+    [[nodiscard]] int at(const Point &p) const { return field[p.y * breite + p.x]; }
+};
+
+// Steuert pro Tick nur ueber das zwischengespeicherte Feld: eine kleine BFS um den Kopf
+// (lokale Reparatur, beachtet den Body) waehlt die Zelle mit minimalem Schritte + Feldwert,
+// von dort geht es bergab bis zum Essen. Suchen zu anderen Zielen (z.B. zum Schwanz)
+// laufen ueber die normale BFS, ebenso wenn der Weg bergab durch den Body fuehren wuerde.
+// Gefuehrt wird zum naechsten Essen laut Feld, goal entscheidet
+// nur, ob das Feld ueberhaupt zustaendig ist.
+class DistanceFieldPathfinder : public Pathfinder {
+private:
+    // Groesse des Reparaturfensters um den Kopf (expandierte Zellen)
+    static constexpr int LOCAL_REPAIR_CELLS = 64;
+
+    DistanceField field;
+    std::vector<Point> sources;     // aktuelle Essen-Positionen
+    bool sourcesKnown = false;      // ohne onFoodChanged() gibt es kein Feld
+
+    // Normale BFS ueber dieselben Puffer (Schwanz-Suche, Body im Weg)
+    template<typename Body>
+    bool fallback(Point start, Point goal, const Grid &grid, const Body &snake, std::vector<Point> &out);
+    template<typename Body>
+    bool steer(Point start, Point goal, const Grid &grid, const Body &snake, std::vector<Point> &out);
+
+public:
+    using Pathfinder::findPath;
+    bool findPath(Point start, Point goal, const Grid &grid, const Snake &snake, std::vector<Point> &out) override;
+    bool findPath(Point start, Point goal, const Grid &grid, const VirtualSnake &snake, std::vector<Point> &out) override;
+
+    void onFoodChanged(const std::vector<Point> &foodPositions) override;
+    void onLevelChanged() override { field.invalidate(); }
+};
+
+#endif //SNAKEGAME_DISTANCEFIELD_H
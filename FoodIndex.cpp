@@ -0,0 +1,182 @@
+#include "FoodIndex.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+void FoodIndex::reset(int w, int h) {
+    breite = w;
+    hohe = h;
+    bucketsX = (w + BUCKET - 1) / BUCKET;
+    bucketsY = (h + BUCKET - 1) / BUCKET;
+    const size_t cells = static_cast<size_t>(w) * h;
+    slot.assign(cells, -1);
+    next.assign(cells, -1);
+    prev.assign(cells, -1);
+    bucketHead.assign(static_cast<size_t>(bucketsX) * bucketsY, -1);
+    items.clear();
+}
+
+void FoodIndex::clear() {
+    for (const Point &p : items) {
+        const int cell = p.y * breite + p.x;
+        slot[cell] = next[cell] = prev[cell] = -1;
+        bucketHead[bucketOf(p.x, p.y)] = -1;
+    }
+    items.clear();
+}
+
+bool FoodIndex::contains(const Point &p) const {
+    if (p.x < 0 || p.x >= breite || p.y < 0 || p.y >= hohe) {
+        return false;
+    }
+    return slot[p.y * breite + p.x] >= 0;
+}
+
+bool FoodIndex::insert(const Point &p) {
+    if (p.x < 0 || p.x >= breite || p.y < 0 || p.y >= hohe) {
+        return false;
+    }
+    const int cell = p.y * breite + p.x;
+    if (slot[cell] >= 0) {
+        return false;
+    }
+    slot[cell] = static_cast<int>(items.size());
+    items.push_back(p);
+    // Kandidaten der k-Suche wachsen mit items mit, damit die Anfrage selbst nie allokiert
+    if (candidates.capacity() < items.capacity()) {
+        candidates.reserve(items.capacity());
+    }
+    // Vorne in die Liste des Eimers haengen
+    int &head = bucketHead[bucketOf(p.x, p.y)];
+    next[cell] = head;
+    prev[cell] = -1;
+    if (head >= 0) prev[head] = cell;
+    head = cell;
+    return true;
+}
+
+bool FoodIndex::remove(const Point &p) {
+    if (!contains(p)) {
+        return false;
+    }
+    const int cell = p.y * breite + p.x;
+    // Aus der Liste des Eimers aushaengen
+    if (prev[cell] >= 0) {
+        next[prev[cell]] = next[cell];
+    } else {
+        bucketHead[bucketOf(p.x, p.y)] = next[cell];
+    }
+    if (next[cell] >= 0) prev[next[cell]] = prev[cell];
+    next[cell] = prev[cell] = -1;
+
+    // Letztes Element in die Luecke von items schieben
+    const int at = slot[cell];
+    const Point last = items.back();
+    items[at] = last;
+    slot[last.y * breite + last.x] = at;
+    items.pop_back();
+    slot[cell] = -1;
+    return true;
+}
+
+template<class F>
+void FoodIndex::forEachInRing(int bx, int by, int r, F &&f) const {
+    if (r == 0) {
+        f(by * bucketsX + bx);
+        return;
+    }
+    const int x0 = std::max(0, bx - r);
+    const int x1 = std::min(bucketsX - 1, bx + r);
+    // Obere und untere Zeile des Rings komplett, links/rechts nur die Spalten dazwischen
+    if (by - r >= 0) {
+        for (int x = x0; x <= x1; x++) f((by - r) * bucketsX + x);
+    }
+    if (by + r < bucketsY) {
+        for (int x = x0; x <= x1; x++) f((by + r) * bucketsX + x);
+    }
+    const int y0 = std::max(0, by - r + 1);
+    const int y1 = std::min(bucketsY - 1, by + r - 1);
+    for (int y = y0; y <= y1; y++) {
+        if (bx - r >= 0) f(y * bucketsX + bx - r);
+        if (bx + r < bucketsX) f(y * bucketsX + bx + r);
+    }
+}
+
+int FoodIndex::maxRing(int bx, int by) const {
+    return std::max(std::max(bx, bucketsX - 1 - bx), std::max(by, bucketsY - 1 - by));
+}
+
+Point FoodIndex::nearest(const Point &p) const {
+    const bool inside = p.x >= 0 && p.x < breite && p.y >= 0 && p.y < hohe;
+    Point best(-1, -1);
+    int bestDistance = std::numeric_limits<int>::max();
+    if (items.size() <= LINEAR_LIMIT || !inside) {
+        for (const Point &food : items) {
+            const int distance = std::abs(p.x - food.x) + std::abs(p.y - food.y);
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                best = food;
+            }
+        }
+        return best;
+    }
+
+    const int bx = p.x / BUCKET;
+    const int by = p.y / BUCKET;
+    const int rings = maxRing(bx, by);
+    for (int r = 0; r <= rings; r++) {
+        forEachInRing(bx, by, r, [&](int bucket) {
+            for (int cell = bucketHead[bucket]; cell >= 0; cell = next[cell]) {
+                const int x = cell % breite;
+                const int y = cell / breite;
+                const int distance = std::abs(p.x - x) + std::abs(p.y - y);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = Point(x, y);
+                }
+            }
+        });
+        // Jede Zelle ab Ring r+1 ist mindestens r*BUCKET+1 entfernt
+        if (bestDistance <= r * BUCKET) {
+            break;
+        }
+    }
+    return best;
+}
+
+void FoodIndex::nearest(const Point &p, size_t k, std::vector<Point> &out) {
+    out.clear();
+    candidates.clear();
+    k = std::min(k, items.size());
+    if (k == 0) {
+        return;
+    }
+    const bool inside = p.x >= 0 && p.x < breite && p.y >= 0 && p.y < hohe;
+    if (items.size() <= LINEAR_LIMIT || !inside) {
+        for (const Point &food : items) {
+            candidates.emplace_back(std::abs(p.x - food.x) + std::abs(p.y - food.y), food.y * breite + food.x);
+        }
+    } else {
+        const int bx = p.x / BUCKET;
+        const int by = p.y / BUCKET;
+        const int rings = maxRing(bx, by);
+        for (int r = 0; r <= rings; r++) {
+            forEachInRing(bx, by, r, [&](int bucket) {
+                for (int cell = bucketHead[bucket]; cell >= 0; cell = next[cell]) {
+                    candidates.emplace_back(std::abs(p.x - cell % breite) + std::abs(p.y - cell / breite), cell);
+                }
+            });
+            if (candidates.size() >= k) {
+                // Die k-te Distanz steht fest, sobald kein weiterer Ring mehr darunter liegen kann
+                std::nth_element(candidates.begin(), candidates.begin() + static_cast<long>(k - 1), candidates.end());
+                if (candidates[k - 1].first <= r * BUCKET) {
+                    break;
+                }
+            }
+        }
+    }
+    std::partial_sort(candidates.begin(), candidates.begin() + static_cast<long>(k), candidates.end());
+    for (size_t i = 0; i < k; i++) {
+        out.emplace_back(candidates[i].second % breite, candidates[i].second / breite);
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef SNAKEGAME_FOODINDEX_H
+#define SNAKEGAME_FOODINDEX_H
+
+#include "common.h"
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+// Raeumlicher Index fuer Essen: das Grid ist in BUCKET x BUCKET grosse Eimer geteilt, jeder Eimer
+// haelt seine Essen als verkettete Liste ueber flache Arrays pro Zelle. Einfuegen, Entfernen und
+// "liegt hier Essen?" sind O(1) und allokieren nach reset() nicht mehr.
+// Naechstes Essen (Manhattan) sucht ringweise um den Eimer der Anfrage und hoert auf, sobald kein
+// weiterer Ring mehr naeher sein kann. Bei wenigen Essen ist ein linearer Durchlauf schneller.
+class FoodIndex {
+public:
+    static constexpr int BUCKET = 8;
+
+    // Leert den Index und passt ihn an die Grid-Groesse an
+    void reset(int breite, int hohe);
+    void clear();
+
+    // false, wenn ausserhalb oder schon vorhanden (insert) bzw. nicht vorhanden (remove)
+    bool insert(const Point &p);
+    bool remove(const Point &p);
+    [[nodiscard]] bool contains(const Point &p) const;
+
+    [[nodiscard]] size_t size() const { return items.size(); }
+    [[nodiscard]] bool empty() const { return items.empty(); }
+    // Alle Essen als dichte Liste; Entfernen tauscht das letzte Element nach vorn
+    [[nodiscard]] const std::vector<Point> &positions() const { return items; }
+
+    // Naechstes Essen nach Manhattan-Distanz, (-1, -1) wenn keins da ist
+    [[nodiscard]] Point nearest(const Point &p) const;
+    // Die k naechsten Essen aufsteigend nach Distanz in out (out wird geleert)
+    void nearest(const Point &p, size_t k, std::vector<Point> &out);
+
+private:
+    // Bis hierhin ist ein Durchlauf ueber alle Essen billiger als die Eimer abzulaufen
+    static constexpr size_t LINEAR_LIMIT = 16;
+
+    int breite = 0;
+    int hohe = 0;
+    int bucketsX = 0;
+    int bucketsY = 0;
+    std::vector<Point> items;
+    std::vector<int> slot;          // pro Zelle: Position in items, -1 = kein Essen
+    std::vector<int> next;          // pro Zelle: naechste/vorige Zelle im selben Eimer, -1 = Ende
+    std::vector<int> prev;
+    std::vector<int> bucketHead;    // pro Eimer: erste Zelle der Liste, -1 = leer
+    std::vector<std::pair<int, int>> candidates;   // (Distanz, Zelle) fuer die k-Suche
+
+    [[nodiscard]] int bucketOf(int x, int y) const { return (y / BUCKET) * bucketsX + x / BUCKET; }
+    // Ruft f(eimer) fuer alle Eimer mit Chebyshev-Abstand r zu (bx, by) auf
+    template<class F>
+    void forEachInRing(int bx, int by, int r, F &&f) const;
+    [[nodiscard]] int maxRing(int bx, int by) const;
+};
+
+#endif //SNAKEGAME_FOODINDEX_H
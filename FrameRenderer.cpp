@@ -0,0 +1,86 @@
+#include "FrameRenderer.h"
+#include <algorithm>
+
+namespace {
+    // Wie Grid::renderToSDL; der SDL-Renderer mischt nicht (Blend-Modus NONE), die Alpha-Werte
+    // des Pfad-Overlays spielen dort also auch keine Rolle
+    constexpr uint8_t COLOR_EMPTY[3] = {0, 0, 0};
+    constexpr uint8_t COLOR_WALL[3] = {128, 128, 128};
+    constexpr uint8_t COLOR_BODY[3] = {0, 200, 0};
+    constexpr uint8_t COLOR_FOOD[3] = {255, 0, 0};
+    constexpr uint8_t COLOR_BORDER[3] = {255, 255, 255};
+    constexpr uint8_t COLOR_PATH[3] = {255, 255, 0};
+    constexpr uint8_t COLOR_PATH_BORDER[3] = {255, 200, 0};
+}
+
+void FrameRenderer::resize(int b, int h, int size) {
+    breite = b;
+    hohe = h;
+    cellSize = std::max(1, size);
+    cells.assign(static_cast<size_t>(breite) * hohe, EMPTY);
+}
+
+void FrameRenderer::fillRect(uint8_t *out, int x, int y, int w, int h, const uint8_t *color) const {
+    const size_t stride = static_cast<size_t>(width()) * 3;
+    for (int row = y; row < y + h; row++) {
+        uint8_t *p = out + row * stride + static_cast<size_t>(x) * 3;
+        for (int i = 0; i < w; i++, p += 3) {
+            p[0] = color[0];
+            p[1] = color[1];
+            p[2] = color[2];
+        }
+    }
+}
+
+void FrameRenderer::drawRect(uint8_t *out, int x, int y, int w, int h, const uint8_t *color) const {
+    if (w <= 0 || h <= 0) return;
+    fillRect(out, x, y, w, 1, color);
+    fillRect(out, x, y + h - 1, w, 1, color);
+    fillRect(out, x, y, 1, h, color);
+    fillRect(out, x + w - 1, y, 1, h, color);
+}
+
+void FrameRenderer::render(const Grid &grid, const Snake &snake, const std::vector<Point> &food,
+                           const std::vector<Point> &path, uint8_t *out) {
+    // Brett zusammensetzen wie Game::render: Waende, Essen, Schlange darueber, Pfad nur auf Leerem
+    const CellType *gridCells = grid.data();
+    for (size_t i = 0; i < cells.size(); i++) {
+        cells[i] = gridCells[i] == CellType::WALL ? WALL : EMPTY;
+    }
+    for (const Point &p : food) {
+        if (grid.isInBounds(p)) cells[p.y * breite + p.x] = FOOD;
+    }
+    for (const Point &segment : snake.getBody()) {
+        if (grid.isInBounds(segment)) cells[segment.y * breite + segment.x] = BODY;
+    }
+    for (const Point &p : path) {
+        if (grid.isInBounds(p) && cells[p.y * breite + p.x] == EMPTY) cells[p.y * breite + p.x] = PATH;
+    }
+
+    for (int y = 0; y < hohe; y++) {
+        for (int x = 0; x < breite; x++) {
+            const int px = x * cellSize;
+            const int py = y * cellSize;
+            switch (cells[y * breite + x]) {
+                case WALL:
+                case BODY:
+                case FOOD: {
+                    const Kind kind = static_cast<Kind>(cells[y * breite + x]);
+                    fillRect(out, px, py, cellSize, cellSize,
+                             kind == WALL ? COLOR_WALL : kind == BODY ? COLOR_BODY : COLOR_FOOD);
+                    drawRect(out, px, py, cellSize, cellSize, COLOR_BORDER);
+                    break;
+                }
+                case PATH:
+                    fillRect(out, px, py, cellSize, cellSize, COLOR_EMPTY);
+                    // Gleicher Versatz wie renderPathOverlay, bei sehr kleinen Zellen bleibt nichts uebrig
+                    fillRect(out, px + 2, py + 2, cellSize - 4, cellSize - 4, COLOR_PATH);
+                    drawRect(out, px + 2, py + 2, cellSize - 4, cellSize - 4, COLOR_PATH_BORDER);
+                    break;
+                default:
+                    fillRect(out, px, py, cellSize, cellSize, COLOR_EMPTY);
+                    break;
+            }
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef SNAKEGAME_FRAMERENDERER_H
+#define SNAKEGAME_FRAMERENDERER_H
+
+#include "grid.h"
+#include "Snake.h"
+#include <cstdint>
+#include <vector>
+
+// Software-Renderer ohne SDL: zeichnet das Brett wie Grid::renderToSDL (gleiche Farben, weisse
+// Raender, Pfad-Overlay) in einen RGB-Puffer, 3 Bytes pro Pixel, Zeilen ohne Padding.
+// Laeuft headless und damit so schnell, wie die Simulation Ticks liefert. Das HUD fehlt
+// (dafuer braeuchte es TTF und einen SDL-Renderer).
+class FrameRenderer {
+public:
+    FrameRenderer() = default;
+
+    // Einmal vor dem ersten Frame, danach allokiert render() nicht mehr
+    void resize(int breite, int hohe, int cellSize);
+
+    [[nodiscard]] int width() const { return breite * cellSize; }
+    [[nodiscard]] int height() const { return hohe * cellSize; }
+    [[nodiscard]] size_t frameBytes() const { return static_cast<size_t>(width()) * height() * 3; }
+
+    // Waende aus dem Grid, darueber Essen, Schlange und (nur auf leeren Zellen) der Pfad.
+    // out muss frameBytes() gross sein
+    void render(const Grid &grid, const Snake &snake, const std::vector<Point> &food,
+                const std::vector<Point> &path, uint8_t *out);
+
+private:
+    enum Kind : uint8_t { EMPTY, WALL, BODY, FOOD, PATH };
+
+    int breite = 0;
+    int hohe = 0;
+    int cellSize = 1;
+    std::vector<uint8_t> cells;     // zusammengesetztes Brett, eine Kind pro Zelle
+
+    void fillRect(uint8_t *out, int x, int y, int w, int h, const uint8_t *color) const;
+    void drawRect(uint8_t *out, int x, int y, int w, int h, const uint8_t *color) const;
+};
+
+#endif //SNAKEGAME_FRAMERENDERER_H
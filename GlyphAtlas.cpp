@@ -0,0 +1,135 @@
+#include "GlyphAtlas.h"
+#include <algorithm>
+
+GlyphAtlas::~GlyphAtlas() {
+    cleanup();
+}
+
+bool GlyphAtlas::init(SDL_Renderer* renderer, TTF_Font* font) {
+    cleanup();
+    if (!renderer || !font) {
+        return false;
+    }
+    const SDL_Color white{255, 255, 255, 255};
+    constexpr int count = LAST_CHAR - FIRST_CHAR + 1;
+    SDL_Surface* surfaces[count] = {};
+
+    // Erst alle Glyphen rastern und zeilenweise anordnen (1 px Abstand gegen Ueberblenden)
+    int penX = 1;
+    int penY = 1;
+    int rowHeight = 0;
+    for (int i = 0; i < count; i++) {
+        const Uint16 ch = static_cast<Uint16>(FIRST_CHAR + i);
+        Glyph &glyph = glyphs_[i];
+        int minx = 0, maxx = 0, miny = 0, maxy = 0, advance = 0;
+        if (TTF_GlyphMetrics(font, ch, &minx, &maxx, &miny, &maxy, &advance) == 0) {
+            glyph.offsetX = std::min(minx, 0);
+            glyph.advance = advance;
+        }
+        surfaces[i] = TTF_RenderGlyph_Blended(font, ch, white);
+        if (!surfaces[i]) {
+            continue;   // z.B. Leerzeichen ohne Pixel, advance reicht
+        }
+        if (penX + surfaces[i]->w + 1 > ATLAS_WIDTH) {
+            penX = 1;
+            penY += rowHeight + 1;
+            rowHeight = 0;
+        }
+        glyph.src = SDL_Rect{penX, penY, surfaces[i]->w, surfaces[i]->h};
+        penX += surfaces[i]->w + 1;
+        rowHeight = std::max(rowHeight, surfaces[i]->h);
+        lineHeight_ = std::max(lineHeight_, surfaces[i]->h);
+    }
+    atlasWidth_ = ATLAS_WIDTH;
+    atlasHeight_ = penY + rowHeight + 1;
+
+    // Dann in eine RGBA-Flaeche kopieren (ohne Blending, damit Alpha erhalten bleibt)
+    SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, atlasWidth_, atlasHeight_, 32, SDL_PIXELFORMAT_RGBA32);
+    if (atlas) {
+        for (int i = 0; i < count; i++) {
+            if (!surfaces[i]) continue;
+            SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+            SDL_Rect dst = glyphs_[i].src;
+            SDL_BlitSurface(surfaces[i], nullptr, atlas, &dst);
+        }
+        texture_ = SDL_CreateTextureFromSurface(renderer, atlas);
+        SDL_FreeSurface(atlas);
+    }
+    for (SDL_Surface* surf : surfaces) {
+        if (surf) SDL_FreeSurface(surf);
+    }
+    if (!texture_) {
+        SDL_Log("GlyphAtlas: Failed to create atlas texture: %s", SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureBlendMode(texture_, SDL_BLENDMODE_BLEND);
+
+    // Platz fuer typische HUD-Zeilen, damit spaeter pro Frame nichts allokiert wird
+    vertices_.reserve(256 * 4);
+    indices_.reserve(256 * 6);
+    return true;
+}
+
+void GlyphAtlas::cleanup() {
+    if (texture_) {
+        SDL_DestroyTexture(texture_);
+        texture_ = nullptr;
+    }
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::glyphFor(char c) const {
+    const int code = static_cast<unsigned char>(c);
+    if (code < FIRST_CHAR || code > LAST_CHAR) {
+        return &glyphs_['?' - FIRST_CHAR];
+    }
+    return &glyphs_[code - FIRST_CHAR];
+}
+
+int GlyphAtlas::measure(const char* text) const {
+    int width = 0;
+    for (const char* c = text; *c; ++c) {
+        width += glyphFor(*c)->advance;
+    }
+    return width;
+}
+
+int GlyphAtlas::drawText(SDL_Renderer* renderer, int x, int y, const char* text, SDL_Color color) {
+    if (!texture_ || !renderer) {
+        return 0;
+    }
+    vertices_.clear();
+    indices_.clear();
+
+    const float invW = 1.0f / static_cast<float>(atlasWidth_);
+    const float invH = 1.0f / static_cast<float>(atlasHeight_);
+    int penX = x;
+    for (const char* c = text; *c; ++c) {
+        const Glyph &glyph = *glyphFor(*c);
+        if (glyph.src.w > 0) {
+            // Ein Quad pro Zeichen: zwei Dreiecke ueber vier Ecken
+            const float left = static_cast<float>(penX + glyph.offsetX);
+            const float top = static_cast<float>(y);
+            const float right = left + static_cast<float>(glyph.src.w);
+            const float bottom = top + static_cast<float>(glyph.src.h);
+            const float u0 = static_cast<float>(glyph.src.x) * invW;
+            const float v0 = static_cast<float>(glyph.src.y) * invH;
+            const float u1 = static_cast<float>(glyph.src.x + glyph.src.w) * invW;
+            const float v1 = static_cast<float>(glyph.src.y + glyph.src.h) * invH;
+
+            const int base = static_cast<int>(vertices_.size());
+            vertices_.push_back(SDL_Vertex{{left, top}, color, {u0, v0}});
+            vertices_.push_back(SDL_Vertex{{right, top}, color, {u1, v0}});
+            vertices_.push_back(SDL_Vertex{{right, bottom}, color, {u1, v1}});
+            vertices_.push_back(SDL_Vertex{{left, bottom}, color, {u0, v1}});
+            const int quad[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+            indices_.insert(indices_.end(), quad, quad + 6);
+        }
+        penX += glyph.advance;
+    }
+
+    if (!vertices_.empty()) {
+        SDL_RenderGeometry(renderer, texture_, vertices_.data(), static_cast<int>(vertices_.size()),
+                           indices_.data(), static_cast<int>(indices_.size()));
+    }
+    return penX - x;
+}
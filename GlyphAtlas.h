@@ -0,0 +1,52 @@
+#ifndef SNAKEGAME_GLYPHATLAS_H
+#define SNAKEGAME_GLYPHATLAS_H
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <vector>
+
+// Glyphen-Atlas: alle druckbaren ASCII-Zeichen werden bei init() einmal mit TTF gerastert
+// und in eine Textur gepackt. Danach kostet Text nur noch Vertices: ein SDL_RenderGeometry
+// Aufruf pro String, ohne TTF und ohne neue Texturen pro Frame.
+class GlyphAtlas {
+private:
+    static constexpr int FIRST_CHAR = 32;
+    static constexpr int LAST_CHAR = 126;
+    static constexpr int ATLAS_WIDTH = 512;
+
+    struct Glyph {
+        SDL_Rect src{0, 0, 0, 0};   // Bereich im Atlas
+        int offsetX = 0;            // minx aus den Glyph-Metriken
+        int advance = 0;
+    };
+
+    SDL_Texture* texture_ = nullptr;
+    int atlasWidth_ = 0;
+    int atlasHeight_ = 0;
+    int lineHeight_ = 0;
+    Glyph glyphs_[LAST_CHAR - FIRST_CHAR + 1];
+
+    // Wiederverwendete Puffer fuer die Quads (wachsen nur beim laengsten String)
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int> indices_;
+
+    [[nodiscard]] const Glyph* glyphFor(char c) const;
+
+public:
+    GlyphAtlas() = default;
+    ~GlyphAtlas();
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    // Rastert den Zeichensatz aus font (weiss, eingefaerbt wird ueber die Vertex-Farbe)
+    bool init(SDL_Renderer* renderer, TTF_Font* font);
+    void cleanup();
+    [[nodiscard]] bool isReady() const { return texture_ != nullptr; }
+
+    // Zeichnet text mit der oberen linken Ecke bei (x, y), Rueckgabe: Breite in Pixeln
+    int drawText(SDL_Renderer* renderer, int x, int y, const char* text, SDL_Color color);
+    [[nodiscard]] int measure(const char* text) const;
+    [[nodiscard]] int lineHeight() const { return lineHeight_; }
+};
+
+#endif //SNAKEGAME_GLYPHATLAS_H
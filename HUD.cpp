@@ -1,8 +1,10 @@
 #include "HUD.h"
+#include <cstdio>
 
 HUD::HUD()
-        : font_(nullptr), scoreTexture_(nullptr), lastScore_(-1),
-          scoreColor_{255, 255, 0, 255}, instrColor_{255, 255, 255, 255},instrTexture_(nullptr)
+        : font_(nullptr), score_(0),
+          fpsWindowStart_(0), fpsFrames_(0), fps_(0.0),
+          scoreColor_{255, 255, 0, 255}, instrColor_{255, 255, 255, 255}, statsColor_{0, 255, 255, 255}
 {}
 
 HUD::~HUD() {
@@ -15,86 +17,65 @@ bool HUD::init(SDL_Renderer* renderer, const std::string& fontPath, int fontSize
         SDL_Log("HUD: Failed to load font %s: %s", fontPath.c_str(), TTF_GetError());
         return false;
     }
-    std::string combined = "W/A/S/D or Arrows: Move   "
-                           "SPACE: Toggle AutoPlay   "
-                           "P: Pause/Resume   "
-                           "1: BFS, 2: Dijkstra (Toggle Algo)   "
-                           "R: Restart (after Game Over)   "
-                           "Esc/Q: Quit";
-    // Erzeuge eine Texture:
-    SDL_Rect rect;
-    instrTexture_ = createTextTexture(renderer, combined, rect, instrColor_);
-    if (instrTexture_) {
-        instrRect_ = rect;
-        instrRect_.x = 0;
-        instrRect_.y = 570; // oder wo immer du sie anzeigen willst
-    } else {
-        SDL_Log("HUD: Failed to create combined instruction texture");
+    instructions_ = "W/A/S/D or Arrows: Move   "
+                    "SPACE: Toggle AutoPlay   "
+                    "P: Pause/Resume   "
+                    "1: BFS, 2: Dijkstra, 3: Distanzfeld, 4: HPA*, 5: D* Lite, 6: Parallele BFS (Toggle Algo)   "
+                    "H: Hamilton   "
+                    "R: Restart (after Game Over)   "
+                    "Esc/Q: Quit";
+    // Zeichensatz einmal rastern, danach wird kein Text mehr mit TTF gerendert
+    if (!atlas_.init(renderer, font_)) {
+        SDL_Log("HUD: Failed to create glyph atlas");
+        return false;
     }
     return true;
 }
 
-SDL_Texture* HUD::createTextTexture(SDL_Renderer* renderer, const std::string& text, SDL_Rect& outRect, SDL_Color color) {
-    SDL_Surface* surf = TTF_RenderText_Blended(font_, text.c_str(), color);
-    if (!surf) {
-        SDL_Log("HUD: TTF_RenderText_Blended error: %s", TTF_GetError());
-        return nullptr;
-    }
-    SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-    if (!tex) {
-        SDL_Log("HUD: SDL_CreateTextureFromSurface error: %s", SDL_GetError());
-        SDL_FreeSurface(surf);
-        return nullptr;
-    }
-    outRect.w = surf->w;
-    outRect.h = surf->h;
-    SDL_FreeSurface(surf);
-    return tex;
+void HUD::updateScore(int newScore) {
+    // Der Text wird beim Rendern aus dem Atlas gebaut, hier muss nichts neu erzeugt werden
+    score_ = newScore;
 }
 
-void HUD::updateScore(int newScore, SDL_Renderer* renderer, int windowWidth) {
-    if (newScore == lastScore_) return;
-    lastScore_ = newScore;
-    // Destroy old
-    if (scoreTexture_) {
-        SDL_DestroyTexture(scoreTexture_);
-        scoreTexture_ = nullptr;
+void HUD::render(SDL_Renderer* renderer, int windowWidth, int windowHeight) {
+    // FPS mitzaehlen (render() laeuft genau einmal pro Frame)
+    const Uint32 now = SDL_GetTicks();
+    fpsFrames_++;
+    if (now - fpsWindowStart_ >= 500) {
+        fps_ = fpsFrames_ * 1000.0 / static_cast<double>(now - fpsWindowStart_);
+        fpsWindowStart_ = now;
+        fpsFrames_ = 0;
     }
-    char buf[64];
-    std::snprintf(buf, sizeof(buf), "Score: %d", newScore);
-    SDL_Rect rect;
-    SDL_Texture* tex = createTextTexture(renderer, buf, rect, scoreColor_);
-    if (tex) {
-        scoreTexture_ = tex;
-        scoreRect_ = rect;
-        // Die X-Position wird in render() basierend auf der aktuellen windowWidth festgelegt
+    if (!atlas_.isReady()) {
+        return;
     }
-}
 
-void HUD::render(SDL_Renderer* renderer, int windowWidth, int windowHeight) {
-    // Rendern statische instructions
-    if(instrTexture_) {
-        SDL_RenderCopy(renderer, instrTexture_, nullptr, &instrRect_);
-    }
+    // Rendern statische instructions am unteren Rand
+    atlas_.drawText(renderer, 0, windowHeight - 30, instructions_.c_str(), instrColor_);
+
     // Rendern score nach oben-recht mit 10px margin
-    if (scoreTexture_) {
-        scoreRect_.x = windowWidth - scoreRect_.w - 10;
-        scoreRect_.y = 10;
-        SDL_RenderCopy(renderer, scoreTexture_, nullptr, &scoreRect_);
+    char buf[128];
+    std::snprintf(buf, sizeof(buf), "Score: %d", score_);
+    atlas_.drawText(renderer, windowWidth - atlas_.measure(buf) - 10, 10, buf, scoreColor_);
+
+    // Statistik oben links
+    std::snprintf(buf, sizeof(buf), "FPS: %.0f   Tick: %.1f us   Pfad: %zu   Knoten: %zu   Eingabe: %.0f ms",
+                  fps_, stats_.tickMicros, stats_.pathLength, stats_.nodesExpanded, stats_.inputLatencyMs);
+    atlas_.drawText(renderer, 10, 10, buf, statsColor_);
+
+    // Darunter Simulationstempo (im Turbo-Modus laufen viel mehr Ticks als Frames)
+    if (stats_.speed == 0) {
+        std::snprintf(buf, sizeof(buf), "Ticks/s: %.0f   Tempo: max", stats_.ticksPerSecond);
+    } else {
+        std::snprintf(buf, sizeof(buf), "Ticks/s: %.0f   Tempo: %dx", stats_.ticksPerSecond, stats_.speed);
     }
+    atlas_.drawText(renderer, 10, 10 + atlas_.lineHeight(), buf, statsColor_);
 }
 
 void HUD::cleanup() {
-    if (scoreTexture_) {
-        SDL_DestroyTexture(scoreTexture_);
-        scoreTexture_ = nullptr;
-    }
-    if (instrTexture_) {
-        SDL_DestroyTexture(instrTexture_);
-        instrTexture_ = nullptr;
-    }
+    atlas_.cleanup();
     if (font_) {
         TTF_CloseFont(font_);
         font_ = nullptr;
     }
-}
\ No newline at end of file
+}
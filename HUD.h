@@ -4,23 +4,36 @@
 #include <SDL_ttf.h>
 #include <string>
 #include <vector>
+#include "GlyphAtlas.h"
+
+// Live-Werte fuer die Statistik-Zeile, werden vom Spiel jeden Frame gesetzt
+struct HUDStats {
+    double tickMicros = 0.0;    // Dauer des letzten Simulationsschritts
+    size_t pathLength = 0;
+    size_t nodesExpanded = 0;   // expandierte Knoten im letzten Tick
+    double inputLatencyMs = 0.0; // Tastendruck bis Zug
+    double ticksPerSecond = 0.0; // erreichte Simulations-Ticks pro Sekunde
+    int speed = 1;              // Tempo-Faktor, 0 = unbegrenzt
+};
 
 class HUD {
 private:
     TTF_Font* font_;
-    SDL_Texture* scoreTexture_;
-    SDL_Rect scoreRect_;
-    int lastScore_;
+    // Alle Texte laufen ueber den Atlas, Zahlen aendern sich also ohne TTF-Aufruf
+    GlyphAtlas atlas_;
+    int score_;
+
+    std::string instructions_;
+    HUDStats stats_;
 
-    // Statische instruction textures
-    SDL_Texture* instrTexture_;
-    SDL_Rect instrRect_;
+    // FPS wird ueber ein Fenster von ~500ms gemittelt
+    Uint32 fpsWindowStart_;
+    int fpsFrames_;
+    double fps_;
 
     SDL_Color scoreColor_;
     SDL_Color instrColor_;
-
-    // Helfer zum Erstellen einer Textur aus Text, outRect.w/h wird aus der Oberfläche festgelegt
-    SDL_Texture* createTextTexture(SDL_Renderer* renderer, const std::string& text, SDL_Rect& outRect, SDL_Color color);
+    SDL_Color statsColor_;
 
 public:
     HUD();
@@ -30,7 +43,9 @@ public:
     bool init(SDL_Renderer* renderer, const std::string& fontPath, int fontSize);
 
     // Rufen Sie an, wenn sich der score ändert
-    void updateScore(int newScore, SDL_Renderer* renderer, int windowWidth);
+    void updateScore(int newScore);
+    // Neue Werte fuer die Statistik-Zeile (kostet nur ein Kopieren)
+    void setStats(const HUDStats& stats) { stats_ = stats; }
 
 
     void render(SDL_Renderer* renderer, int windowWidth, int windowHeight);
@@ -0,0 +1,435 @@
+#include "HamiltonCycle.h"
+#include "Arena.h"
+#include "Log.h"
+#include <array>
+#include <algorithm>
+
+namespace {
+    // Verbindungen eines 2x2-Blocks zu seinen Nachbarbloecken im Spannbaum
+    constexpr unsigned char LINK_LEFT  = 1;
+    constexpr unsigned char LINK_RIGHT = 2;
+    constexpr unsigned char LINK_UP    = 4;
+    constexpr unsigned char LINK_DOWN  = 8;
+
+    // Mindestabstand zum Schwanz, damit Wachstum waehrend einer Abkuerzung Platz hat
+    constexpr int SHORTCUT_BUFFER = 3;
+
+    // Obergrenze fuer das Backtracking: ~30 ns pro Knoten, also hoechstens einige ms auf dem Tick-Thread.
+    // Was die Bloecke nicht schaffen und hier nicht passt, spielt eben ohne Kreis (normaler Pathfinder)
+    constexpr long long BACKTRACK_NODE_BUDGET = 200'000;
+}
+
+void HamiltonCycle::clear() {
+    cycle.clear();
+    cycleIndex.clear();
+    foodAt.clear();
+    nextFood.clear();
+    foodCount = 0;
+    valid = false;
+}
+
+bool HamiltonCycle::build(const Grid &grid, const std::vector<Point> &foodPositions) {
+    clear();
+    breite = grid.getBreite();
+    hohe = grid.getHohe();
+
+    // Alle Puffer beim Bauen sind temporaer und kommen aus memoryResource
+    ArenaScope scope(memoryResource);
+    // Freie Zellen = alles ausser Waenden (Snake und Essen bewegen sich, die Waende nicht)
+    std::pmr::vector<char> free(static_cast<size_t>(breite) * hohe, 0, memoryResource);
+    int freeCount = 0;
+    int black = 0;
+    for (int y = 0; y < hohe; y++) {
+        for (int x = 0; x < breite; x++) {
+            if (grid.getCell(x, y) != CellType::WALL) {
+                free[y * breite + x] = 1;
+                freeCount++;
+                if ((x + y) % 2 == 0) black++;
+            }
+        }
+    }
+    if (freeCount < 4) {
+        SNAKE_LOG_INFO("Hamilton: zu wenige freie Zellen");
+        return false;
+    }
+    // Das Grid ist bipartit: ein Kreis wechselt immer die Farbe, also muessen beide Farben gleich oft vorkommen
+    if (black * 2 != freeCount) {
+        SNAKE_LOG_INFO("Hamilton: kein Kreis moeglich (Schachbrett-Farben unausgeglichen: %d / %d)",
+                       black, freeCount - black);
+        return false;
+    }
+    // Jede freie Zelle braucht mindestens zwei freie Nachbarn
+    for (int y = 0; y < hohe; y++) {
+        for (int x = 0; x < breite; x++) {
+            if (!free[y * breite + x]) continue;
+            int degree = 0;
+            for (const Point &dir : Directions::ALL_DIRECTIONS) {
+                Point n = {x + dir.x, y + dir.y};
+                if (grid.isInBounds(n) && free[n.y * breite + n.x]) degree++;
+            }
+            if (degree < 2) {
+                SNAKE_LOG_INFO("Hamilton: kein Kreis moeglich (Sackgasse bei (%d,%d))", x, y);
+                return false;
+            }
+        }
+    }
+
+    for (int offsetY = 0; offsetY < 2 && !valid; offsetY++) {
+        for (int offsetX = 0; offsetX < 2 && !valid; offsetX++) {
+            valid = buildFromBlocks(free, freeCount, offsetX, offsetY);
+        }
+    }
+    if (!valid) {
+        valid = buildBacktracking(free, freeCount, BACKTRACK_NODE_BUDGET);
+    }
+    if (!valid) {
+        SNAKE_LOG_WARN("Hamilton: kein Kreis gefunden (Backtracking nach %lld Knoten abgebrochen)",
+                       BACKTRACK_NODE_BUDGET);
+        clear();
+        return false;
+    }
+    SNAKE_LOG_INFO("Hamilton: Kreis ueber %zu Zellen berechnet", cycle.size());
+    setFood(foodPositions);
+    return true;
+}
+
+void HamiltonCycle::setFood(const std::vector<Point> &foodPositions) {
+    const int n = size();
+    foodAt.assign(n, 0);
+    nextFood.assign(n, -1);
+    foodCount = 0;
+    for (const Point &p : foodPositions) {
+        const int pos = positionOf(p);
+        if (pos >= 0 && !foodAt[pos]) {
+            foodAt[pos] = 1;
+            foodCount++;
+        }
+    }
+    if (foodCount == 0) return;
+    // Rueckwaerts ueber zwei Runden, damit auch die Positionen hinter dem letzten Essen ihr Ziel finden
+    int next = -1;
+    for (int i = 2 * n - 1; i >= 0; i--) {
+        const int pos = i % n;
+        if (foodAt[pos]) next = pos;
+        if (i < n) nextFood[pos] = next;
+    }
+}
+
+void HamiltonCycle::fillNextFood(int pos, int target) {
+    const int n = size();
+    int i = pos;
+    do {
+        nextFood[i] = target;
+        i = i == 0 ? n - 1 : i - 1;
+    } while (i != pos && !foodAt[i]);
+}
+
+void HamiltonCycle::addFood(const Point &p) {
+    const int pos = positionOf(p);
+    if (pos < 0 || foodAt[pos]) return;
+    foodAt[pos] = 1;
+    foodCount++;
+    fillNextFood(pos, pos);
+}
+
+void HamiltonCycle::removeFood(const Point &p) {
+    const int pos = positionOf(p);
+    if (pos < 0 || !foodAt[pos]) return;
+    foodAt[pos] = 0;
+    foodCount--;
+    // Ohne pos zeigt der Nachfolger schon auf das naechste verbliebene Essen
+    fillNextFood(pos, foodCount == 0 ? -1 : nextFood[(pos + 1) % size()]);
+}
+
+bool HamiltonCycle::buildFromBlocks(const std::pmr::vector<char> &free, int freeCount, int offsetX, int offsetY) {
+    const int blocksX = (breite - offsetX) / 2;
+    const int blocksY = (hohe - offsetY) / 2;
+    if (blocksX <= 0 || blocksY <= 0) return false;
+
+    // Jede freie Zelle muss in einem komplett freien 2x2-Block liegen
+    std::pmr::vector<char> blockFree(static_cast<size_t>(blocksX) * blocksY, 0, memoryResource);
+    int firstBlock = -1;
+    for (int by = 0; by < blocksY; by++) {
+        for (int bx = 0; bx < blocksX; bx++) {
+            int x = offsetX + bx * 2;
+            int y = offsetY + by * 2;
+            bool allFree = free[y * breite + x] && free[y * breite + x + 1]
+                           && free[(y + 1) * breite + x] && free[(y + 1) * breite + x + 1];
+            if (allFree) {
+                blockFree[by * blocksX + bx] = 1;
+                if (firstBlock < 0) firstBlock = by * blocksX + bx;
+            }
+        }
+    }
+    int coveredCells = 0;
+    for (char b : blockFree) coveredCells += b ? 4 : 0;
+    if (firstBlock < 0 || coveredCells != freeCount) return false;
+
+    // Spannbaum ueber die freien Bloecke (BFS)
+    std::pmr::vector<unsigned char> links(blockFree.size(), 0, memoryResource);
+    std::pmr::vector<char> reached(blockFree.size(), 0, memoryResource);
+    std::pmr::vector<int> queue(memoryResource);
+    queue.reserve(blockFree.size());
+    queue.push_back(firstBlock);
+    reached[firstBlock] = 1;
+    int reachedCount = 1;
+    for (size_t read = 0; read < queue.size(); read++) {
+        int b = queue[read];
+        int bx = b % blocksX;
+        int by = b / blocksX;
+
+        const std::array<std::array<int, 4>, 4> steps = {{
+            {-1, 0, LINK_LEFT, LINK_RIGHT},
+            { 1, 0, LINK_RIGHT, LINK_LEFT},
+            { 0, -1, LINK_UP, LINK_DOWN},
+            { 0, 1, LINK_DOWN, LINK_UP},
+        }};
+        for (const auto &step : steps) {
+            int nx = bx + step[0];
+            int ny = by + step[1];
+            if (nx < 0 || nx >= blocksX || ny < 0 || ny >= blocksY) continue;
+            int n = ny * blocksX + nx;
+            if (!blockFree[n] || reached[n]) continue;
+            reached[n] = 1;
+            reachedCount++;
+            links[b] |= step[2];
+            links[n] |= step[3];
+            queue.push_back(n);
+        }
+    }
+    if (reachedCount * 4 != coveredCells) return false;
+
+    // Kreis um den Spannbaum herum: innerhalb eines Blocks gegen den Uhrzeigersinn,
+    // eine Baumkante oeffnet den Uebergang in den Nachbarblock
+    cycle.clear();
+    cycle.reserve(freeCount);
+    int startX = offsetX + (firstBlock % blocksX) * 2;
+    int startY = offsetY + (firstBlock / blocksX) * 2;
+    int x = startX;
+    int y = startY;
+    for (int i = 0; i < freeCount; i++) {
+        cycle.push_back(y * breite + x);
+        int bx = (x - offsetX) / 2;
+        int by = (y - offsetY) / 2;
+        unsigned char link = links[by * blocksX + bx];
+        bool left = ((x - offsetX) % 2) == 0;
+        bool top = ((y - offsetY) % 2) == 0;
+
+        if (left && top) {
+            if (link & LINK_LEFT) x--; else y++;
+        } else if (left) {
+            if (link & LINK_DOWN) y++; else x++;
+        } else if (!top) {
+            if (link & LINK_RIGHT) x++; else y--;
+        } else {
+            if (link & LINK_UP) y--; else x--;
+        }
+    }
+    if (x != startX || y != startY) return false;
+    return verifyAndIndex(free, freeCount);
+}
+
+bool HamiltonCycle::buildBacktracking(const std::pmr::vector<char> &free, int freeCount, long long nodeBudget) {
+    int start = -1;
+    for (int i = 0; i < static_cast<int>(free.size()); i++) {
+        if (free[i]) { start = i; break; }
+    }
+    if (start < 0) return false;
+
+    std::pmr::vector<char> visited(free.size(), 0, memoryResource);
+
+    auto neighborsOf = [&](int cell, std::array<int, 4> &out) {
+        int count = 0;
+        Point p = toPoint(cell);
+        for (const Point &dir : Directions::ALL_DIRECTIONS) {
+            int nx = p.x + dir.x;
+            int ny = p.y + dir.y;
+            if (nx < 0 || nx >= breite || ny < 0 || ny >= hohe) continue;
+            int n = ny * breite + nx;
+            if (free[n]) out[count++] = n;
+        }
+        return count;
+    };
+
+    // Expliziter Stack statt Rekursion, damit grosse Grids den Aufrufstack nicht sprengen
+    struct Frame {
+        int cell;
+        std::array<int, 4> next;
+        int count;
+        int pos;
+    };
+    std::pmr::vector<Frame> stack(memoryResource);
+    stack.reserve(freeCount);
+
+    auto pushFrame = [&](int cell) {
+        Frame frame{cell, {}, 0, 0};
+        std::array<int, 4> all{};
+        int total = neighborsOf(cell, all);
+        std::array<int, 4> onward{};
+        for (int i = 0; i < total; i++) {
+            if (visited[all[i]]) continue;
+            std::array<int, 4> second{};
+            int secondCount = neighborsOf(all[i], second);
+            int degree = 0;
+            for (int j = 0; j < secondCount; j++) {
+                if (!visited[second[j]]) degree++;
+            }
+            onward[frame.count] = degree;
+            frame.next[frame.count++] = all[i];
+        }
+        // Warnsdorff: Nachbarn mit den wenigsten Weiterzuegen zuerst
+        for (int i = 1; i < frame.count; i++) {
+            for (int j = i; j > 0 && onward[j] < onward[j - 1]; j--) {
+                std::swap(onward[j], onward[j - 1]);
+                std::swap(frame.next[j], frame.next[j - 1]);
+            }
+        }
+        visited[cell] = 1;
+        stack.push_back(frame);
+    };
+
+    // Pruning: nach dem Schritt from -> to muss jede freie Nachbarzelle von from noch zwei
+    // moegliche Kreisnachbarn haben, und der Start muss noch erreichbar bleiben, um den Kreis zu schliessen
+    auto canStep = [&](int from, int to) {
+        std::array<int, 4> around{};
+        int count = neighborsOf(from, around);
+        for (int i = 0; i < count; i++) {
+            int u = around[i];
+            if (u == to || visited[u]) continue;
+            std::array<int, 4> second{};
+            int secondCount = neighborsOf(u, second);
+            int options = 0;
+            for (int j = 0; j < secondCount; j++) {
+                int w = second[j];
+                if (!visited[w] || w == start || w == to) options++;
+            }
+            if (options < 2) return false;
+        }
+        if (static_cast<int>(stack.size()) + 1 < freeCount) {
+            int startCount = neighborsOf(start, around);
+            int open = 0;
+            for (int i = 0; i < startCount; i++) {
+                if (!visited[around[i]] || around[i] == to) open++;
+            }
+            if (open == 0) return false;
+        }
+        return true;
+    };
+
+    pushFrame(start);
+    while (!stack.empty()) {
+        if (--nodeBudget < 0) return false;
+
+        Frame &frame = stack.back();
+        if (static_cast<int>(stack.size()) == freeCount) {
+            std::array<int, 4> around{};
+            int count = neighborsOf(frame.cell, around);
+            if (std::find(around.begin(), around.begin() + count, start) != around.begin() + count) {
+                cycle.clear();
+                cycle.reserve(freeCount);
+                for (const Frame &f : stack) cycle.push_back(f.cell);
+                return verifyAndIndex(free, freeCount);
+            }
+        }
+        if (frame.pos < frame.count) {
+            int next = frame.next[frame.pos++];
+            if (!visited[next] && canStep(frame.cell, next)) {
+                pushFrame(next);
+            }
+        } else {
+            visited[frame.cell] = 0;
+            stack.pop_back();
+        }
+    }
+    return false;
+}
+
+bool HamiltonCycle::verifyAndIndex(const std::pmr::vector<char> &free, int freeCount) {
+    if (static_cast<int>(cycle.size()) != freeCount) return false;
+
+    cycleIndex.assign(free.size(), -1);
+    for (int i = 0; i < freeCount; i++) {
+        int cell = cycle[i];
+        if (!free[cell] || cycleIndex[cell] != -1) return false;
+
+        Point a = toPoint(cell);
+        Point b = toPoint(cycle[(i + 1) % freeCount]);
+        if (std::abs(a.x - b.x) + std::abs(a.y - b.y) != 1) return false;
+        cycleIndex[cell] = i;
+    }
+    return true;
+}
+
+int HamiltonCycle::distance(int fromPos, int toPos) const {
+    int d = toPos - fromPos;
+    return d < 0 ? d + static_cast<int>(cycle.size()) : d;
+}
+
+int HamiltonCycle::positionOf(const Point &p) const {
+    if (!valid || p.x < 0 || p.x >= breite || p.y < 0 || p.y >= hohe) return -1;
+    return cycleIndex[p.y * breite + p.x];
+}
+
+bool HamiltonCycle::isBodyOrdered(const Snake &snake) const {
+    if (!valid) return false;
+    // Vom Kopf Richtung Schwanz muss jede Zelle im Kreis vor der vorherigen liegen,
+    // und alle Abstaende zusammen duerfen den Kreis nicht einmal umrunden
+    const auto body = snake.getBody();
+    int previous = positionOf(body.front());
+    if (previous < 0) return false;
+    long long span = 0;
+    for (size_t i = 1; i < body.size(); i++) {
+        int pos = positionOf(body[i]);
+        if (pos < 0) return false;
+        int d = distance(pos, previous);
+        if (d == 0) return false;
+        span += d;
+        previous = pos;
+    }
+    return span < static_cast<long long>(cycle.size());
+}
+
+Direction HamiltonCycle::nextMove(const Snake &snake) const {
+    if (!valid) return Direction::NONE;
+
+    const Point head = snake.getHeadPosition();
+    const int headPos = positionOf(head);
+    if (headPos < 0) return Direction::NONE;
+
+    const int n = size();
+    const int length = static_cast<int>(snake.getLength());
+    const int tailPos = positionOf(snake.getTailPosition());
+    const int distTail = (length == 1) ? n : distance(headPos, tailPos);
+
+    // Naechstes Essen entlang des Kreises (ohne das unter dem Kopf), ein Lookup in nextFood
+    int distFood = n;
+    if (foodCount > 0) {
+        const int foodPos = nextFood[(headPos + 1) % n];
+        if (foodPos != headPos) distFood = distance(headPos, foodPos);
+    }
+
+    // Wie weit darf gesprungen werden, ohne am Schwanz vorbeizulaufen?
+    int allowed = distTail - 1 - SHORTCUT_BUFFER;
+    if (snake.isGrowing()) allowed--;
+    if (distFood < distTail) allowed--;            // Essen auf dem Weg: Schwanz bleibt einen Zug stehen
+    const int emptyCells = n - length - foodCount;
+    if (emptyCells < n / 2) allowed = 1;           // ab halb vollem Brett nur noch dem Kreis folgen
+    allowed = std::clamp(allowed, 1, std::max(1, distFood));
+
+    // Groesste Abkuerzung unter den Nachbarn (Tabellen-Lookup, O(1))
+    Direction best = Direction::NONE;
+    int bestDist = 0;
+    const std::array<Direction, 4> dirs = {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT};
+    for (size_t i = 0; i < dirs.size(); i++) {
+        Point next = head + Directions::ALL_DIRECTIONS[i];
+        int pos = positionOf(next);
+        if (pos < 0) continue;
+        int d = distance(headPos, pos);
+        if (d == 0 || d > allowed || snake.blocksCell(next)) continue;
+        if (d > bestDist) {
+            bestDist = d;
+            best = dirs[i];
+        }
+    }
+    return best;
+}
@@ -0,0 +1,64 @@
+#ifndef SNAKEGAME_HAMILTONCYCLE_H
+#define SNAKEGAME_HAMILTONCYCLE_H
+
+#include "Snake.h"
+#include <vector>
+#include <memory_resource>
+
+// Hamilton-Kreis ueber alle freien Zellen eines Levels (Autopilot, der nie stirbt).
+// Der Kreis wird einmal pro Level berechnet, danach ist jede Entscheidung O(1):
+// cycleIndex liefert fuer jede Zelle ihre Position im Kreis, nextFood das naechste Essen
+// dahinter, daraus ergibt sich die groesste sichere Abkuerzung in Richtung Essen.
+class HamiltonCycle {
+private:
+    int breite = 0;
+    int hohe = 0;
+    std::vector<int> cycle;         // Zellindizes (y * breite + x) in Kreisreihenfolge
+    std::vector<int> cycleIndex;    // Zellindex -> Position im Kreis, -1 = Wand
+    bool valid = false;
+    // Essen auf dem Kreis: foodAt je Kreisposition, nextFood = Kreisposition des naechsten Essens ab
+    // dort (sie selbst eingeschlossen), -1 ohne Essen. addFood/removeFood ziehen nur die Luecke bis
+    // zum vorherigen Essen nach, nextMove braucht so keinen Durchlauf ueber alle Essen
+    std::vector<char> foodAt;
+    std::vector<int> nextFood;
+    int foodCount = 0;
+    // Herkunft der temporaeren Puffer beim Bauen (z.B. die Tick-Arena des Spiels)
+    std::pmr::memory_resource *memoryResource = std::pmr::get_default_resource();
+
+    // Konstruktion ueber einen Spannbaum aus freien 2x2-Bloecken (schnell, deckt die meisten Level ab)
+    bool buildFromBlocks(const std::pmr::vector<char> &free, int freeCount, int offsetX, int offsetY);
+    // Fallback: Backtracking-Suche mit Warnsdorff-Heuristik, hart begrenzt auf nodeBudget Knoten
+    bool buildBacktracking(const std::pmr::vector<char> &free, int freeCount, long long nodeBudget);
+    // Prueft, dass cycle ein geschlossener Kreis ueber alle freien Zellen ist, und fuellt cycleIndex
+    bool verifyAndIndex(const std::pmr::vector<char> &free, int freeCount);
+    void setFood(const std::vector<Point> &foodPositions);
+    // nextFood ab pos rueckwaerts auf target setzen, bis zum vorherigen Essen (das zeigt auf sich selbst)
+    void fillNextFood(int pos, int target);
+
+    [[nodiscard]] Point toPoint(int index) const { return {index % breite, index / breite}; }
+
+public:
+    // Berechnet den Kreis fuer die aktuellen Waende und sortiert das Essen ein.
+    // false = es existiert keiner (oder wurde nicht gefunden)
+    bool build(const Grid &grid, const std::vector<Point> &foodPositions);
+    // Essen-Aenderungen nachziehen, O(Abstand zum vorherigen Essen auf dem Kreis); ohne Kreis wirkungslos
+    void addFood(const Point &p);
+    void removeFood(const Point &p);
+    void setMemoryResource(std::pmr::memory_resource *resource) { memoryResource = resource; }
+    void clear();
+
+    [[nodiscard]] bool isValid() const { return valid; }
+    [[nodiscard]] int size() const { return static_cast<int>(cycle.size()); }
+
+    // Vorwaerts-Distanz entlang des Kreises
+    [[nodiscard]] int distance(int fromPos, int toPos) const;
+    [[nodiscard]] int positionOf(const Point &p) const;
+
+    // Liegt der Body vom Schwanz bis zum Kopf in Kreisreihenfolge? Nur dann sind Abkuerzungen sicher
+    [[nodiscard]] bool isBodyOrdered(const Snake &snake) const;
+
+    // Naechster Zug: groesste sichere Abkuerzung Richtung naechstes Essen, sonst dem Kreis folgen
+    [[nodiscard]] Direction nextMove(const Snake &snake) const;
+};
+
+#endif //SNAKEGAME_HAMILTONCYCLE_H
@@ -0,0 +1,449 @@
+#include "HierarchicalPathfinder.h"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+HierarchicalPathfinder::Rect HierarchicalPathfinder::clusterRect(int c) const {
+    const int cx = c % clustersX;
+    const int cy = c / clustersX;
+    return {cx * CLUSTER_SIZE, cy * CLUSTER_SIZE,
+            std::min((cx + 1) * CLUSTER_SIZE, breite), std::min((cy + 1) * CLUSTER_SIZE, hohe)};
+}
+
+HierarchicalPathfinder::Rect HierarchicalPathfinder::windowAround(int x, int y) const {
+    const int cx = x / CLUSTER_SIZE;
+    const int cy = y / CLUSTER_SIZE;
+    return {std::max(cx - 1, 0) * CLUSTER_SIZE, std::max(cy - 1, 0) * CLUSTER_SIZE,
+            std::min((cx + 2) * CLUSTER_SIZE, breite), std::min((cy + 2) * CLUSTER_SIZE, hohe)};
+}
+
+// ---------------------------------------------------------------------------------------------
+// Aufbau
+// ---------------------------------------------------------------------------------------------
+
+void HierarchicalPathfinder::sync(const Grid &grid) {
+    if (grid.getBreite() != breite || grid.getHohe() != hohe) {
+        breite = grid.getBreite();
+        hohe = grid.getHohe();
+        clustersX = (breite + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+        clustersY = (hohe + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+        const size_t count = static_cast<size_t>(clustersX) * clustersY;
+        clusters.assign(count, Cluster{});
+        rightEntrances.assign(count, {});
+        downEntrances.assign(count, {});
+        dirty.assign(count, 0);
+        walls.assign(static_cast<size_t>(breite) * hohe, 2);
+        // Groesstes Suchfenster: 3x3 Cluster
+        const size_t window = static_cast<size_t>(3 * CLUSTER_SIZE) * (3 * CLUSTER_SIZE);
+        regionDist.assign(window, -1);
+        regionFrom.assign(window, -1);
+        regionQueue.assign(window, 0);
+        wallsDirty = true;
+    }
+    if (!wallsDirty) {
+        return;
+    }
+    wallsDirty = false;
+
+    // Nur Cluster mit geaenderten Waenden sind betroffen
+    const CellType *cells = grid.data();
+    bool anyDirty = false;
+    std::fill(dirty.begin(), dirty.end(), 0);
+    for (int y = 0; y < hohe; y++) {
+        for (int x = 0; x < breite; x++) {
+            const int i = y * breite + x;
+            const uint8_t wall = cells[i] == CellType::WALL;
+            if (wall != walls[i]) {
+                walls[i] = wall;
+                dirty[clusterOf(x, y)] = 1;
+                anyDirty = true;
+            }
+        }
+    }
+    rebuiltClusters = 0;
+    if (!anyDirty) {
+        return;
+    }
+
+    const auto isDirty = [&](int cx, int cy) {
+        return cx >= 0 && cy >= 0 && cx < clustersX && cy < clustersY && dirty[cy * clustersX + cx];
+    };
+    // Grenzen neben einem geaenderten Cluster neu bestimmen
+    for (int cy = 0; cy < clustersY; cy++) {
+        for (int cx = 0; cx < clustersX; cx++) {
+            const int c = cy * clustersX + cx;
+            if (isDirty(cx, cy) || isDirty(cx + 1, cy)) buildEntrances(cells, c, true);
+            if (isDirty(cx, cy) || isDirty(cx, cy + 1)) buildEntrances(cells, c, false);
+        }
+    }
+    // Knoten und Entfernungen in allen Clustern, deren Grenzen sich geaendert haben koennen
+    for (int cy = 0; cy < clustersY; cy++) {
+        for (int cx = 0; cx < clustersX; cx++) {
+            if (isDirty(cx, cy) || isDirty(cx - 1, cy) || isDirty(cx + 1, cy) || isDirty(cx, cy - 1) || isDirty(cx, cy + 1)) {
+                const int c = cy * clustersX + cx;
+                collectNodes(c);
+                computeIntra(cells, c);
+                rebuiltClusters++;
+            }
+        }
+    }
+    relink();
+}
+
+void HierarchicalPathfinder::buildEntrances(const CellType *cells, int c, bool right) {
+    auto &entrances = right ? rightEntrances[c] : downEntrances[c];
+    entrances.clear();
+    const Rect r = clusterRect(c);
+    if ((right && r.x1 >= breite) || (!right && r.y1 >= hohe)) {
+        return;
+    }
+    // Entlang der Grenze laufen: freie Paare (hier | Nachbar) bilden Abschnitte
+    const int length = right ? r.y1 - r.y0 : r.x1 - r.x0;
+    const int step = right ? breite : 1;
+    const int first = right ? r.y0 * breite + (r.x1 - 1) : (r.y1 - 1) * breite + r.x0;
+    int runStart = -1;
+    for (int i = 0; i <= length; i++) {
+        const int a = first + i * step;
+        const bool open = i < length && cells[a] != CellType::WALL && cells[a + (right ? 1 : breite)] != CellType::WALL;
+        if (open && runStart < 0) {
+            runStart = i;
+        } else if (!open && runStart >= 0) {
+            const int runLength = i - runStart;
+            const int offset = right ? 1 : breite;
+            if (runLength < SPLIT_ENTRANCE) {
+                const int mid = first + (runStart + runLength / 2) * step;
+                entrances.emplace_back(mid, mid + offset);
+            } else {
+                const int lo = first + runStart * step;
+                const int hi = first + (i - 1) * step;
+                entrances.emplace_back(lo, lo + offset);
+                entrances.emplace_back(hi, hi + offset);
+            }
+            runStart = -1;
+        }
+    }
+}
+
+void HierarchicalPathfinder::collectNodes(int c) {
+    std::vector<int> &nodes = clusters[c].nodes;
+    nodes.clear();
+    auto add = [&](int cell) {
+        if (std::find(nodes.begin(), nodes.end(), cell) == nodes.end()) {
+            nodes.push_back(cell);
+        }
+    };
+    const int cx = c % clustersX;
+    const int cy = c / clustersX;
+    for (const auto &[here, there] : rightEntrances[c]) add(here);
+    for (const auto &[here, there] : downEntrances[c]) add(here);
+    if (cx > 0) {
+        for (const auto &[there, here] : rightEntrances[c - 1]) add(here);
+    }
+    if (cy > 0) {
+        for (const auto &[there, here] : downEntrances[c - clustersX]) add(here);
+    }
+}
+
+void HierarchicalPathfinder::computeIntra(const CellType *cells, int c) {
+    Cluster &cluster = clusters[c];
+    const size_t n = cluster.nodes.size();
+    cluster.dist.assign(n * n, INF);
+    const Rect r = clusterRect(c);
+    for (size_t i = 0; i < n; i++) {
+        regionBfs(cells, NoOccupancy{}, r, cluster.nodes[i], -1);
+        for (size_t j = 0; j < n; j++) {
+            cluster.dist[i * n + j] = regionDistance(cluster.nodes[j]);
+        }
+    }
+}
+
+int HierarchicalPathfinder::nodeId(int c, int cell) const {
+    const std::vector<int> &nodes = clusters[c].nodes;
+    const auto it = std::find(nodes.begin(), nodes.end(), cell);
+    return it == nodes.end() ? -1 : clusters[c].firstNode + static_cast<int>(it - nodes.begin());
+}
+
+void HierarchicalPathfinder::relink() {
+    // Globale Nummern neu vergeben (O(Knoten), nur nach Levelwechseln)
+    int total = 0;
+    for (Cluster &cluster : clusters) {
+        cluster.firstNode = total;
+        total += static_cast<int>(cluster.nodes.size());
+    }
+    nodeCell.resize(total);
+    nodeCluster.resize(total);
+    nodePartner.assign(static_cast<size_t>(total) * 2, -1);
+    for (int c = 0; c < static_cast<int>(clusters.size()); c++) {
+        const Cluster &cluster = clusters[c];
+        for (size_t i = 0; i < cluster.nodes.size(); i++) {
+            nodeCell[cluster.firstNode + i] = cluster.nodes[i];
+            nodeCluster[cluster.firstNode + i] = c;
+        }
+    }
+    auto link = [&](int a, int b) {
+        for (int k = 0; k < 2; k++) {
+            if (nodePartner[2 * a + k] < 0) {
+                nodePartner[2 * a + k] = b;
+                return;
+            }
+        }
+    };
+    for (int c = 0; c < static_cast<int>(clusters.size()); c++) {
+        for (int pass = 0; pass < 2; pass++) {
+            const int neighbor = pass == 0 ? c + 1 : c + clustersX;
+            for (const auto &[here, there] : pass == 0 ? rightEntrances[c] : downEntrances[c]) {
+                const int a = nodeId(c, here);
+                const int b = nodeId(neighbor, there);
+                link(a, b);
+                link(b, a);
+            }
+        }
+    }
+    gCost.resize(total + 2);
+    parent.resize(total + 2);
+    stamp.assign(total + 2, 0);
+    generation = 0;
+}
+
+// ---------------------------------------------------------------------------------------------
+// Suchen
+// ---------------------------------------------------------------------------------------------
+
+template<typename Occupancy>
+bool HierarchicalPathfinder::regionBfs(const CellType *cells, const Occupancy &occupancy, const Rect &r,
+                                       int startCell, int stopCell) {
+    lastRegion = r;
+    // Die Queue arbeitet mit lokalen Indizes, so braucht es pro Zelle nur eine Division
+    const int w = r.width();
+    const int h = r.y1 - r.y0;
+    const int base = r.y0 * breite + r.x0;
+    std::fill(regionDist.begin(), regionDist.begin() + w * h, -1);
+    const auto local = [&](int cell) { return (cell / breite - r.y0) * w + (cell % breite - r.x0); };
+    const int stopLocal = stopCell >= 0 && r.contains(stopCell % breite, stopCell / breite) ? local(stopCell) : -1;
+
+    int read = 0;
+    int write = 0;
+    const int startLocal = local(startCell);
+    regionQueue[write++] = startLocal;
+    regionDist[startLocal] = 0;
+    while (read < write) {
+        const int current = regionQueue[read++];
+        scratch.expanded++;
+        if (current == stopLocal) {
+            return true;
+        }
+        const int ly = current / w;
+        const int lx = current - ly * w;
+        const int cell = base + ly * breite + lx;
+        const int d = regionDist[current] + 1;
+        auto tryCell = [&](int ln, int n) {
+            if (regionDist[ln] >= 0 || cells[n] == CellType::WALL || occupancy.blocksIndex(n)) return;
+            regionDist[ln] = d;
+            regionFrom[ln] = current;
+            regionQueue[write++] = ln;
+        };
+        if (ly > 0) tryCell(current - w, cell - breite);
+        if (ly + 1 < h) tryCell(current + w, cell + breite);
+        if (lx > 0) tryCell(current - 1, cell - 1);
+        if (lx + 1 < w) tryCell(current + 1, cell + 1);
+    }
+    return false;
+}
+
+int HierarchicalPathfinder::regionDistance(int cell) const {
+    const int x = cell % breite;
+    const int y = cell / breite;
+    if (!lastRegion.contains(x, y)) return INF;
+    const int d = regionDist[(y - lastRegion.y0) * lastRegion.width() + (x - lastRegion.x0)];
+    return d < 0 ? INF : d;
+}
+
+void HierarchicalPathfinder::appendRegionPath(int startCell, int goalCell, std::vector<Point> &out) const {
+    const size_t begin = out.size();
+    const int w = lastRegion.width();
+    const auto local = [&](int cell) { return (cell / breite - lastRegion.y0) * w + (cell % breite - lastRegion.x0); };
+    const int startLocal = local(startCell);
+    for (int current = local(goalCell); current != startLocal; current = regionFrom[current]) {
+        out.emplace_back(lastRegion.x0 + current % w, lastRegion.y0 + current / w);
+    }
+    std::reverse(out.begin() + static_cast<long>(begin), out.end());
+}
+
+bool HierarchicalPathfinder::abstractSearch(const CellType *cells, int startCell, int goalCell) {
+    const int total = static_cast<int>(nodeCell.size());
+    const int startNode = total;
+    const int goalNode = total + 1;
+    const int sc = clusterOf(startCell % breite, startCell / breite);
+    const int gc = clusterOf(goalCell % breite, goalCell / breite);
+    const Cluster &startCluster = clusters[sc];
+    const Cluster &goalCluster = clusters[gc];
+
+    // Start und Ziel voruebergehend an die Knoten ihres Clusters anbinden
+    regionBfs(cells, NoOccupancy{}, clusterRect(sc), startCell, -1);
+    startDist.resize(startCluster.nodes.size());
+    for (size_t i = 0; i < startCluster.nodes.size(); i++) {
+        startDist[i] = regionDistance(startCluster.nodes[i]);
+    }
+    const int direct = sc == gc ? regionDistance(goalCell) : INF;
+    regionBfs(cells, NoOccupancy{}, clusterRect(gc), goalCell, -1);
+    goalDist.resize(goalCluster.nodes.size());
+    for (size_t i = 0; i < goalCluster.nodes.size(); i++) {
+        goalDist[i] = regionDistance(goalCluster.nodes[i]);
+    }
+
+    const int gx = goalCell % breite;
+    const int gy = goalCell / breite;
+    auto heuristic = [&](int node) {
+        const int cell = node >= total ? (node == startNode ? startCell : goalCell) : nodeCell[node];
+        return std::abs(cell % breite - gx) + std::abs(cell / breite - gy);
+    };
+    if (++generation == 0) {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        generation = 1;
+    }
+    // stamp == generation: Knoten gesehen, stamp == generation mit gCost < 0: abgeschlossen
+    // Schluessel g + 1.25 * h (in Vierteln), bei Gleichstand der tiefere Knoten zuerst: mit dem
+    // exakten f haben auf offenen Flaechen ganze Plateaus denselben Wert und werden alle expandiert
+    const auto key = [](int g, int h) { return (static_cast<int64_t>(4 * g + 5 * h) << 32) - g; };
+    const auto heapOrder = std::greater<std::pair<int64_t, int>>();
+    open.clear();
+    auto relax = [&](int from, int to, int cost) {
+        const int g = gCost[from] + cost;
+        if (stamp[to] == generation && (gCost[to] < 0 || gCost[to] <= g)) return;
+        stamp[to] = generation;
+        gCost[to] = g;
+        parent[to] = from;
+        open.emplace_back(key(g, heuristic(to)), to);
+        std::push_heap(open.begin(), open.end(), heapOrder);
+    };
+    stamp[startNode] = generation;
+    gCost[startNode] = 0;
+    parent[startNode] = -1;
+    open.emplace_back(key(0, heuristic(startNode)), startNode);
+
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), heapOrder);
+        const auto [k, u] = open.back();
+        open.pop_back();
+        if (gCost[u] < 0 || k != key(gCost[u], heuristic(u))) continue;    // veraltet oder abgeschlossen
+        scratch.expanded++;
+        if (u == goalNode) {
+            abstractPath.clear();
+            for (int node = goalNode; node >= 0; node = parent[node]) {
+                abstractPath.push_back(node);
+            }
+            std::reverse(abstractPath.begin(), abstractPath.end());
+            return true;
+        }
+        const int gu = gCost[u];
+        if (u == startNode) {
+            for (size_t i = 0; i < startDist.size(); i++) {
+                if (startDist[i] < INF) relax(u, startCluster.firstNode + static_cast<int>(i), startDist[i]);
+            }
+            if (direct < INF) relax(u, goalNode, direct);
+        } else {
+            const int c = nodeCluster[u];
+            const Cluster &cluster = clusters[c];
+            const int li = u - cluster.firstNode;
+            const int n = static_cast<int>(cluster.nodes.size());
+            for (int j = 0; j < n; j++) {
+                const int d = cluster.dist[li * n + j];
+                if (j != li && d < INF) relax(u, cluster.firstNode + j, d);
+            }
+            for (int k = 0; k < 2; k++) {
+                const int partner = nodePartner[2 * u + k];
+                if (partner >= 0) relax(u, partner, 1);
+            }
+            if (c == gc && goalDist[li] < INF) relax(u, goalNode, goalDist[li]);
+        }
+        // Abgeschlossen markieren (gCost bleibt fuer die Rekonstruktion nicht noetig)
+        gCost[u] = -1 - gu;
+    }
+    return false;
+}
+
+bool HierarchicalPathfinder::refine(const CellType *cells, int startCell, int goalCell, std::vector<Point> &out) {
+    const int total = static_cast<int>(nodeCell.size());
+    out.clear();
+    int previous = startCell;
+    for (size_t i = 1; i < abstractPath.size(); i++) {
+        const int node = abstractPath[i];
+        const int cell = node == total + 1 ? goalCell : nodeCell[node];
+        if (cell == previous) continue;
+        const int dx = std::abs(cell % breite - previous % breite);
+        const int dy = std::abs(cell / breite - previous / breite);
+        if (dx + dy == 1) {
+            out.emplace_back(cell % breite, cell / breite);
+        } else {
+            // Beide liegen im selben Cluster: dort zellgenau nachsuchen
+            if (!regionBfs(cells, NoOccupancy{}, clusterRect(clusterOf(previous % breite, previous / breite)), previous, cell)) {
+                return false;
+            }
+            appendRegionPath(previous, cell, out);
+        }
+        previous = cell;
+    }
+    return true;
+}
+
+template<typename Body>
+bool HierarchicalPathfinder::search(Point start, Point goal, const Grid &grid, const Body &snake, std::vector<Point> &out) {
+    out.clear();
+    if (!grid.isInBounds(start) || !grid.isInBounds(goal)) {
+        return false;
+    }
+    sync(grid);
+    const CellType *cells = grid.data();
+    const int startCell = start.y * breite + start.x;
+    const int goalCell = goal.y * breite + goal.x;
+    if (startCell == goalCell) {
+        return true;
+    }
+
+    // Nahbereich: Ziel im Fenster um den Kopf, direkt mit Body suchen
+    const Rect window = windowAround(start.x, start.y);
+    if (window.contains(goal.x, goal.y) && regionBfs(cells, snake, window, startCell, goalCell)) {
+        appendRegionPath(startCell, goalCell, out);
+        return true;
+    }
+
+    if (!abstractSearch(cells, startCell, goalCell)) {
+        return false;
+    }
+    if (!refine(cells, startCell, goalCell, refined)) {
+        return false;
+    }
+
+    // Pfadanfang im Fenster mit Body nachsuchen: bis zur letzten Zelle, bevor der Pfad das Fenster verlaesst
+    size_t leave = 0;
+    while (leave < refined.size() && window.contains(refined[leave].x, refined[leave].y)) {
+        leave++;
+    }
+    if (leave == 0) {
+        out.swap(refined);
+        return true;
+    }
+    const Point anchor = refined[leave - 1];
+    const int anchorCell = anchor.y * breite + anchor.x;
+    if (regionBfs(cells, snake, window, startCell, anchorCell)) {
+        appendRegionPath(startCell, anchorCell, out);
+        out.insert(out.end(), refined.begin() + static_cast<long>(leave), refined.end());
+        return true;
+    }
+
+    // Body versperrt den Weg am Kopf: auf kleinen Grids flach suchen, sonst aufgeben
+    if (static_cast<size_t>(breite) * hohe > FLAT_FALLBACK_CELLS) {
+        return false;
+    }
+    return SearchKernels::withGridPolicy(grid, start, [&](const auto &policy) {
+        return SearchKernels::bfs(policy, cells, snake, startCell, goalCell, scratch, out);
+    });
+}
+
+bool HierarchicalPathfinder::findPath(Point start, Point goal, const Grid &grid, const Snake &snake, std::vector<Point> &out) {
+    return search(start, goal, grid, snake, out);
+}
+
+bool HierarchicalPathfinder::findPath(Point start, Point goal, const Grid &grid, const VirtualSnake &snake, std::vector<Point> &out) {
+    return search(start, goal, grid, snake, out);
+}
@@ -0,0 +1,115 @@
+#ifndef SNAKEGAME_HIERARCHICALPATHFINDER_H
+#define SNAKEGAME_HIERARCHICALPATHFINDER_H
+
+#include "Pathfinder.h"
+#include <vector>
+#include <limits>
+
+// HPA*: das Grid wird in Cluster von CLUSTER_SIZE x CLUSTER_SIZE Zellen geteilt. An den
+// Clustergrenzen liegen Uebergaenge (Knoten), pro Cluster sind die Entfernungen zwischen seinen
+// Knoten vorberechnet (nur statische Waende). Eine Anfrage sucht mit A* auf diesem kleinen
+// Graphen (Heuristik mit 1.25 gewichtet, Pfade dafuer etwas laenger) und verfeinert die
+// Teilstrecken danach clusterweise zu Zellen.
+// Die Schlange wird nur im Fenster um den Kopf (3x3 Cluster) beachtet: dort wird der
+// Pfadanfang noch einmal mit dem Body gesucht, der Rest wird in spaeteren Ticks nachgeplant.
+// Nach einem Levelwechsel werden nur Cluster mit geaenderten Waenden (und ihre Nachbarn) neu gebaut.
+class HierarchicalPathfinder : public Pathfinder {
+public:
+    static constexpr int CLUSTER_SIZE = 16;
+
+    using Pathfinder::findPath;
+    bool findPath(Point start, Point goal, const Grid &grid, const Snake &snake, std::vector<Point> &out) override;
+    bool findPath(Point start, Point goal, const Grid &grid, const VirtualSnake &snake, std::vector<Point> &out) override;
+
+    void onLevelChanged() override { wallsDirty = true; }
+
+    // Baut den abstrakten Graphen jetzt auf (sonst beim naechsten findPath)
+    void prepare(const Grid &grid) { sync(grid); }
+
+    // Statistik
+    [[nodiscard]] size_t clusterCount() const { return clusters.size(); }
+    [[nodiscard]] size_t nodeCount() const { return nodeCell.size(); }
+    [[nodiscard]] size_t lastRebuiltClusters() const { return rebuiltClusters; }
+
+private:
+    static constexpr int INF = std::numeric_limits<int>::max();
+    // Bis zu dieser Laenge bekommt ein freier Grenzabschnitt einen Uebergang in der Mitte,
+    // laengere bekommen zwei (an den Enden)
+    static constexpr int SPLIT_ENTRANCE = 6;
+    // Ist der Weg am Kopf vom Body versperrt, wird auf kleinen Grids flach gesucht
+    static constexpr size_t FLAT_FALLBACK_CELLS = 256 * 256;
+
+    struct Rect {
+        int x0, y0, x1, y1;     // x1/y1 exklusiv
+        [[nodiscard]] bool contains(int x, int y) const { return x >= x0 && x < x1 && y >= y0 && y < y1; }
+        [[nodiscard]] int width() const { return x1 - x0; }
+    };
+
+    struct Cluster {
+        std::vector<int> nodes;     // Zellindizes der Uebergaenge in diesem Cluster
+        std::vector<int> dist;      // nodes.size()^2 Entfernungen innerhalb des Clusters (INF = keine)
+        int firstNode = 0;          // globale Knotennummer von nodes[0]
+    };
+
+    int breite = 0;
+    int hohe = 0;
+    int clustersX = 0;
+    int clustersY = 0;
+    bool wallsDirty = true;
+    size_t rebuiltClusters = 0;
+
+    std::vector<uint8_t> walls;         // Waende beim letzten Aufbau (2 = noch nie gesehen)
+    std::vector<uint8_t> dirty;         // pro Cluster: Waende geaendert
+    std::vector<Cluster> clusters;
+    // Uebergaenge (Zelle hier, Zelle im Nachbarn) zum rechten bzw. unteren Nachbarcluster
+    std::vector<std::vector<std::pair<int, int>>> rightEntrances;
+    std::vector<std::vector<std::pair<int, int>>> downEntrances;
+
+    // Abstrakter Graph, global nummeriert
+    std::vector<int> nodeCell;
+    std::vector<int> nodeCluster;
+    std::vector<int> nodePartner;       // 2 pro Knoten: Gegenstueck im Nachbarcluster (-1 = keins)
+
+    // Puffer der Fenster-BFS (lokal indiziert)
+    std::vector<int> regionDist;
+    std::vector<int> regionFrom;
+    std::vector<int> regionQueue;
+    Rect lastRegion{};
+
+    // Puffer der A*-Suche auf dem abstrakten Graphen
+    std::vector<int> gCost;
+    std::vector<int> parent;
+    std::vector<uint32_t> stamp;
+    uint32_t generation = 0;
+    std::vector<std::pair<int64_t, int>> open;
+    std::vector<int> startDist;
+    std::vector<int> goalDist;
+    std::vector<int> abstractPath;
+    std::vector<Point> refined;
+
+    [[nodiscard]] int clusterOf(int x, int y) const { return (y / CLUSTER_SIZE) * clustersX + x / CLUSTER_SIZE; }
+    [[nodiscard]] Rect clusterRect(int c) const;
+    [[nodiscard]] Rect windowAround(int x, int y) const;
+
+    void sync(const Grid &grid);
+    void buildEntrances(const CellType *cells, int c, bool right);
+    void collectNodes(int c);
+    void computeIntra(const CellType *cells, int c);
+    void relink();
+    [[nodiscard]] int nodeId(int c, int cell) const;
+
+    // BFS nur innerhalb von r; stopCell >= 0 bricht dort ab. Rueckgabe: true wenn stopCell erreicht
+    template<typename Occupancy>
+    bool regionBfs(const CellType *cells, const Occupancy &occupancy, const Rect &r, int startCell, int stopCell);
+    [[nodiscard]] int regionDistance(int cell) const;
+    // Haengt den Pfad der letzten regionBfs (ohne Start) an out an
+    void appendRegionPath(int startCell, int goalCell, std::vector<Point> &out) const;
+
+    bool abstractSearch(const CellType *cells, int startCell, int goalCell);
+    bool refine(const CellType *cells, int startCell, int goalCell, std::vector<Point> &out);
+
+    template<typename Body>
+    bool search(Point start, Point goal, const Grid &grid, const Body &snake, std::vector<Point> &out);
+};
+
+#endif //SNAKEGAME_HIERARCHICALPATHFINDER_H
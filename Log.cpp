@@ -0,0 +1,148 @@
+#include "Log.h"
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <thread>
+
+namespace {
+    constexpr size_t CAPACITY = 1024;           // Zweierpotenz
+    constexpr size_t MAX_MESSAGE = 240;
+
+    // Ein Slot traegt seine Sequenznummer: == Position -> frei zum Schreiben,
+    // == Position + 1 -> fertig zum Lesen (begrenzte MPSC-Queue nach Vyukov)
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        Log::Level level = Log::Level::Info;
+        int64_t micros = 0;
+        char text[MAX_MESSAGE] = {};
+    };
+
+    struct Ring {
+        Slot slots[CAPACITY];
+        alignas(64) std::atomic<uint64_t> enqueuePos{0};
+        alignas(64) uint64_t dequeuePos = 0;    // nur der Schreib-Thread
+        std::atomic<uint64_t> dropped{0};
+
+        Ring() {
+            for (size_t i = 0; i < CAPACITY; i++) {
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    Ring ring;
+    const auto startTime = std::chrono::steady_clock::now();
+
+    std::thread writer;
+    std::atomic<bool> running{false};
+    FILE *output = nullptr;
+
+    const char *levelName(Log::Level level) {
+        switch (level) {
+            case Log::Level::Trace: return "TRACE";
+            case Log::Level::Debug: return "DEBUG";
+            case Log::Level::Info:  return "INFO";
+            case Log::Level::Warn:  return "WARN";
+            case Log::Level::Error: return "ERROR";
+        }
+        return "?";
+    }
+
+    // Liest alle fertigen Slots in die Datei, Rueckgabe: Anzahl geschriebener Meldungen
+    size_t drain() {
+        size_t written = 0;
+        while (true) {
+            Slot &slot = ring.slots[ring.dequeuePos & (CAPACITY - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != ring.dequeuePos + 1) {
+                break;
+            }
+            std::fprintf(output, "[%10.3f] %-5s %s\n", static_cast<double>(slot.micros) / 1000.0,
+                         levelName(slot.level), slot.text);
+            // Slot fuer die naechste Runde freigeben
+            slot.sequence.store(ring.dequeuePos + CAPACITY, std::memory_order_release);
+            ring.dequeuePos++;
+            written++;
+        }
+        return written;
+    }
+
+    void writerLoop() {
+        uint64_t reportedDrops = 0;
+        while (running.load(std::memory_order_acquire)) {
+            if (drain() == 0) {
+                const uint64_t dropped = ring.dropped.load(std::memory_order_relaxed);
+                if (dropped != reportedDrops) {
+                    std::fprintf(output, "[Log] %llu Meldungen verworfen (Ring voll)\n",
+                                 static_cast<unsigned long long>(dropped - reportedDrops));
+                    reportedDrops = dropped;
+                }
+                // Nur im Leerlauf flushen, der Tick-Thread wartet nie darauf
+                std::fflush(output);
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        }
+        drain();
+        std::fflush(output);
+    }
+}
+
+bool Log::start(const char *path) {
+    if (running.load()) {
+        return true;
+    }
+    output = path ? std::fopen(path, "w") : nullptr;
+    const bool opened = output != nullptr;
+    if (!opened) {
+        output = stderr;
+    }
+    running.store(true, std::memory_order_release);
+    writer = std::thread(writerLoop);
+    return opened;
+}
+
+void Log::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    writer.join();
+    if (output && output != stderr) {
+        std::fclose(output);
+    }
+    output = nullptr;
+}
+
+void Log::write(Level level, const char *format, ...) {
+    // Slot reservieren, ohne Lock und ohne zu warten
+    uint64_t pos = ring.enqueuePos.load(std::memory_order_relaxed);
+    Slot *slot;
+    while (true) {
+        slot = &ring.slots[pos & (CAPACITY - 1)];
+        const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+        if (diff == 0) {
+            if (ring.enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Ring voll: lieber verwerfen als den Tick aufzuhalten
+            ring.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = ring.enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->level = level;
+    slot->micros = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startTime).count();
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(slot->text, MAX_MESSAGE, format, args);
+    va_end(args);
+
+    slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+uint64_t Log::droppedCount() {
+    return ring.dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,59 @@
+#ifndef SNAKEGAME_LOG_H
+#define SNAKEGAME_LOG_H
+
+#include <atomic>
+#include <cstdint>
+
+// Mindest-Level zur Compile-Zeit: alles darunter verschwindet komplett (Argumente werden nicht
+// ausgewertet). 0 = Trace, 1 = Debug, 2 = Info, 3 = Warn, 4 = Error, 5 = aus.
+// Ohne Angabe: Debug-Builds ab Debug, Release-Builds (NDEBUG) ab Info.
+#ifndef SNAKE_LOG_LEVEL
+#ifdef NDEBUG
+#define SNAKE_LOG_LEVEL 2
+#else
+#define SNAKE_LOG_LEVEL 1
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SNAKE_PRINTF_FORMAT(fmtIndex, argIndex) __attribute__((format(printf, fmtIndex, argIndex)))
+#else
+#define SNAKE_PRINTF_FORMAT(fmtIndex, argIndex)
+#endif
+
+// Asynchrones Logging: write() formatiert direkt in einen Slot eines lock-freien Ringpuffers
+// (mehrere Schreiber, ein Leser) und kehrt sofort zurueck. Ein Hintergrund-Thread schreibt
+// die Meldungen in die Datei. Ist der Ring voll, wird die Meldung verworfen statt zu warten.
+class Log {
+public:
+    enum class Level : int {
+        Trace = 0,
+        Debug = 1,
+        Info = 2,
+        Warn = 3,
+        Error = 4,
+    };
+
+    static constexpr bool enabled(Level level) { return static_cast<int>(level) >= SNAKE_LOG_LEVEL; }
+
+    // Startet den Schreib-Thread (path == nullptr oder nicht beschreibbar: stderr)
+    static bool start(const char *path);
+    // Schreibt alles Ausstehende und beendet den Thread
+    static void stop();
+
+    static void write(Level level, const char *format, ...) SNAKE_PRINTF_FORMAT(2, 3);
+
+    // Wegen vollem Ring verworfene Meldungen seit Programmstart
+    static uint64_t droppedCount();
+};
+
+#define SNAKE_LOG(level, ...) \
+    do { if constexpr (Log::enabled(level)) { Log::write(level, __VA_ARGS__); } } while (0)
+
+#define SNAKE_LOG_TRACE(...) SNAKE_LOG(Log::Level::Trace, __VA_ARGS__)
+#define SNAKE_LOG_DEBUG(...) SNAKE_LOG(Log::Level::Debug, __VA_ARGS__)
+#define SNAKE_LOG_INFO(...)  SNAKE_LOG(Log::Level::Info, __VA_ARGS__)
+#define SNAKE_LOG_WARN(...)  SNAKE_LOG(Log::Level::Warn, __VA_ARGS__)
+#define SNAKE_LOG_ERROR(...) SNAKE_LOG(Log::Level::Error, __VA_ARGS__)
+
+#endif //SNAKEGAME_LOG_H
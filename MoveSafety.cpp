@@ -0,0 +1,129 @@
+#include "MoveSafety.h"
+#include <array>
+#include <algorithm>
+
+namespace {
+    Point offsetOf(Direction dir) {
+        switch (dir) {
+            case Direction::UP:    return Directions::UP;
+            case Direction::DOWN:  return Directions::DOWN;
+            case Direction::LEFT:  return Directions::LEFT;
+            case Direction::RIGHT: return Directions::RIGHT;
+            default:               return {0, 0};
+        }
+    }
+
+    bool isReverse(Direction a, Direction b) {
+        return (a == Direction::UP && b == Direction::DOWN) || (a == Direction::DOWN && b == Direction::UP)
+               || (a == Direction::LEFT && b == Direction::RIGHT) || (a == Direction::RIGHT && b == Direction::LEFT);
+    }
+}
+
+void MoveSafety::ensureSize(const Grid &grid) {
+    if (grid.getBreite() == breite && grid.getHohe() == hohe) return;
+    breite = grid.getBreite();
+    hohe = grid.getHohe();
+    visitedStamp.assign(static_cast<size_t>(breite) * hohe, 0);
+    queue.assign(static_cast<size_t>(breite) * hohe, 0);
+    generation = 0;
+}
+
+void MoveSafety::nextGeneration() {
+    // Bei Ueberlauf einmal komplett zuruecksetzen
+    if (++generation == 0) {
+        std::fill(visitedStamp.begin(), visitedStamp.end(), 0);
+        generation = 1;
+    }
+}
+
+MoveSafetyResult MoveSafety::evaluate(const Grid &grid, const Snake &snake, Direction dir) {
+    MoveSafetyResult result;
+    if (dir == Direction::NONE) return result;
+    ensureSize(grid);
+
+    const Point head = snake.getHeadPosition();
+    const Point target = head + offsetOf(dir);
+    const bool growing = snake.isGrowing();
+    const size_t length = snake.getLength();
+
+    // Ohne Wachstum gibt der Schwanz seine Zelle frei, mit Wachstum bleibt er liegen
+    auto blocked = [&](const Point &p) {
+        if (grid.getCell(p) == CellType::WALL) return true;
+        return growing ? snake.occupies(p) : snake.blocksCell(p);
+    };
+
+    if (!grid.isInBounds(target) || blocked(target)) return result;
+    if (length > 1 && target == snake.getBody()[1]) return result;
+    result.legal = true;
+    result.bodyLength = static_cast<int>(length) + (growing ? 1 : 0);
+
+    // Neuer Schwanz nach dem Zug
+    if (length == 1 && !growing) {
+        result.tailReachable = true;
+    }
+    const Point newTail = growing ? snake.getTailPosition()
+                                  : (length > 1 ? snake.getBody()[length - 2] : target);
+
+    // Begrenzter Flood Fill ab der Zielzelle, Abbruch sobald der Body sicher hineinpasst
+    nextGeneration();
+    const int bound = result.bodyLength;
+    int read = 0;
+    int write = 0;
+    queue[write++] = target.y * breite + target.x;
+    visitedStamp[target.y * breite + target.x] = generation;
+    int area = 0;
+
+    while (read < write && area <= bound) {
+        int index = queue[read++];
+        Point current = {index % breite, index / breite};
+        area++;
+
+        for (const Point &d : Directions::ALL_DIRECTIONS) {
+            Point next = current + d;
+            if (!grid.isInBounds(next)) continue;
+            if (next == newTail) {
+                result.tailReachable = true;
+            }
+            int nextIndex = next.y * breite + next.x;
+            if (visitedStamp[nextIndex] == generation || blocked(next)) continue;
+            visitedStamp[nextIndex] = generation;
+            queue[write++] = nextIndex;
+        }
+    }
+    result.reachableArea = area;
+    return result;
+}
+
+Direction MoveSafety::chooseSafest(const Grid &grid, const Snake &snake, Direction preferred, Direction travel) {
+    // Umkehr heisst: zurueck in body[1], also gegen die Richtung, in der die Schlange wirklich laeuft
+    const Direction current = travel;
+    if (preferred == Direction::NONE || (snake.getLength() > 1 && isReverse(current, preferred))) {
+        preferred = current;
+    }
+
+    MoveSafetyResult preferredResult = evaluate(grid, snake, preferred);
+    if (preferredResult.isSafe()) {
+        return preferred;
+    }
+
+    // Alle drei Kandidaten (geradeaus, links, rechts) bewerten: sicher > Schwanz erreichbar > Flaeche
+    Direction best = preferredResult.legal ? preferred : Direction::NONE;
+    MoveSafetyResult bestResult = preferredResult;
+    const std::array<Direction, 4> candidates = {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT};
+    for (Direction dir : candidates) {
+        if (dir == preferred || (snake.getLength() > 1 && isReverse(current, dir))) continue;
+
+        MoveSafetyResult r = evaluate(grid, snake, dir);
+        if (!r.legal) continue;
+        bool better = !bestResult.legal
+                      || (r.isSafe() && !bestResult.isSafe())
+                      || (r.isSafe() == bestResult.isSafe() && r.tailReachable && !bestResult.tailReachable)
+                      || (r.isSafe() == bestResult.isSafe() && r.tailReachable == bestResult.tailReachable
+                          && r.reachableArea > bestResult.reachableArea);
+        if (better) {
+            best = dir;
+            bestResult = r;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,41 @@
+#ifndef SNAKEGAME_MOVESAFETY_H
+#define SNAKEGAME_MOVESAFETY_H
+
+#include "Snake.h"
+#include <vector>
+#include <cstdint>
+
+// Ergebnis der Bewertung eines Kandidatenzugs
+struct MoveSafetyResult {
+    bool legal = false;           // Zielzelle ist weder Wand noch Body
+    int reachableArea = 0;        // erreichbare freie Zellen nach dem Zug (begrenzt auf Laenge + 1)
+    bool tailReachable = false;   // Schwanz ist nach dem Zug noch erreichbar
+    int bodyLength = 0;           // Laenge nach dem Zug
+
+    // Sicher = genug Platz fuer den ganzen Body oder der Schwanz ist erreichbar (er macht Platz)
+    [[nodiscard]] bool isSafe() const { return legal && (tailReachable || reachableArea > bodyLength); }
+};
+
+// Bewertet Zuege per begrenztem Flood Fill, um Sackgassen kleiner als die Schlange zu vermeiden.
+// Alle Puffer sind vorab allokiert; "besucht" wird ueber einen Generationszaehler markiert,
+// damit zwischen zwei Aufrufen nichts geloescht werden muss.
+class MoveSafety {
+private:
+    int breite = 0;
+    int hohe = 0;
+    std::vector<uint32_t> visitedStamp;
+    uint32_t generation = 0;
+    std::vector<int> queue;
+
+    void ensureSize(const Grid &grid);
+    void nextGeneration();
+
+public:
+    MoveSafetyResult evaluate(const Grid &grid, const Snake &snake, Direction dir);
+
+    // Liefert preferred, wenn der Zug sicher ist, sonst den besten der drei moeglichen Zuege.
+    // travel ist die Richtung des letzten Zugs (nicht snake.getDirection(), die kann schon der Plan sein)
+    Direction chooseSafest(const Grid &grid, const Snake &snake, Direction preferred, Direction travel);
+};
+
+#endif //SNAKEGAME_MOVESAFETY_H
@@ -0,0 +1,94 @@
+#include "MovingAI.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace MovingAI {
+
+    bool loadMap(const std::string &path, Grid &grid) {
+        std::ifstream in(path);
+        if (!in) {
+            std::cerr << "MovingAI: " << path << " kann nicht gelesen werden\n";
+            return false;
+        }
+        // Kopf: Schluessel/Wert-Paare bis "map"
+        int breite = 0;
+        int hohe = 0;
+        std::string key;
+        while (in >> key && key != "map") {
+            if (key == "height") {
+                in >> hohe;
+            } else if (key == "width") {
+                in >> breite;
+            } else {
+                std::string value;
+                in >> value;    // "type octile" u.ae.
+            }
+        }
+        if (key != "map" || breite <= 0 || hohe <= 0) {
+            std::cerr << "MovingAI: " << path << " hat keinen gueltigen Kopf\n";
+            return false;
+        }
+
+        grid = Grid(breite, hohe, false);
+        std::string row;
+        bool closed = true;     // Rand komplett blockiert?
+        for (int y = 0; y < hohe; y++) {
+            if (!(in >> row) || static_cast<int>(row.size()) < breite) {
+                std::cerr << "MovingAI: " << path << " endet in Zeile " << y << "\n";
+                return false;
+            }
+            for (int x = 0; x < breite; x++) {
+                const char c = row[x];
+                const bool passable = c == '.' || c == 'G' || c == 'S';
+                if (!passable) {
+                    grid.setCell(x, y, CellType::WALL);
+                } else if (x == 0 || y == 0 || x == breite - 1 || y == hohe - 1) {
+                    closed = false;
+                }
+            }
+        }
+        if (closed) {
+            // Setzt nur Waende, die schon da sind, und schaltet die Rand-Garantie ein
+            grid.initializeWalls();
+        }
+        return true;
+    }
+
+    bool loadScenarios(const std::string &path, std::vector<Scenario> &out) {
+        std::ifstream in(path);
+        if (!in) {
+            std::cerr << "MovingAI: " << path << " kann nicht gelesen werden\n";
+            return false;
+        }
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(in, line)) {
+            lineNumber++;
+            if (line.empty() || line.rfind("version", 0) == 0) {
+                continue;
+            }
+            std::istringstream fields(line);
+            Scenario s;
+            if (!(fields >> s.bucket >> s.map >> s.mapBreite >> s.mapHohe
+                         >> s.start.x >> s.start.y >> s.goal.x >> s.goal.y >> s.optimal)) {
+                std::cerr << "MovingAI: " << path << ":" << lineNumber << " ist kein Szenario\n";
+                return false;
+            }
+            out.push_back(s);
+        }
+        return true;
+    }
+
+    std::string resolveMapPath(const std::string &scenarioPath, const std::string &map) {
+        namespace fs = std::filesystem;
+        const fs::path dir = fs::path(scenarioPath).parent_path();
+        for (const fs::path &candidate : {fs::path(map), dir / map, dir / fs::path(map).filename()}) {
+            std::error_code error;
+            if (fs::is_regular_file(candidate, error)) {
+                return candidate.string();
+            }
+        }
+        return map;
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef SNAKEGAME_MOVINGAI_H
+#define SNAKEGAME_MOVINGAI_H
+
+#include "grid.h"
+#include <string>
+#include <vector>
+
+// Karten und Szenarien im Textformat der MovingAI-Benchmarks (.map/.scen, Sturtevant 2012),
+// damit sich die Pfadfinder mit veroeffentlichten Grid-Ergebnissen vergleichen lassen.
+// .map:  "type octile", "height H", "width W", "map", dann H Zeilen mit W Zeichen.
+//        Begehbar sind '.', 'G' und 'S', alles andere ('@', 'O', 'T', 'W') wird Wand.
+// .scen: "version 1", dann pro Zeile: Bucket Karte Breite Hoehe StartX StartY ZielX ZielY Optimal.
+//        Optimal ist die Laenge mit Diagonalen (Kosten sqrt 2, keine Ecken schneiden).
+namespace MovingAI {
+
+    struct Scenario {
+        int bucket = 0;
+        std::string map;            // Kartenpfad wie in der Datei (meist relativ)
+        int mapBreite = 0;
+        int mapHohe = 0;
+        Point start;
+        Point goal;
+        double optimal = 0.0;       // Oktil-Laenge laut Datei
+    };
+
+    // Liest die Karte in grid (wird neu angelegt). Ist der Rand komplett blockiert, bekommt das
+    // Grid die Rand-Garantie und die Suchkerne laufen ohne Bounds-Checks.
+    bool loadMap(const std::string &path, Grid &grid);
+
+    // Haengt alle Szenarien der Datei an out an
+    bool loadScenarios(const std::string &path, std::vector<Scenario> &out);
+
+    // Pfad der Karte eines Szenarios: wie angegeben, relativ zur .scen-Datei oder nur der
+    // Dateiname neben der .scen-Datei (die Archive legen die Karten unterschiedlich ab)
+    std::string resolveMapPath(const std::string &scenarioPath, const std::string &map);
+}
+
+#endif //SNAKEGAME_MOVINGAI_H
@@ -1,25 +1,30 @@
 #include "ObstacleGenerator.h"
+#include "Arena.h"
+#include <array>
 
 // Hilfsfunktion für Pathfinding
 bool ObstacleGenerator::canReachAllAreas(const Point& start) {
-    std::vector<std::vector<bool>> visited(hohe, std::vector<bool>(breite, false));
-    std::queue<Point> queue;
-
-    queue.push(start);
-    visited[start.y][start.x] = true;
+    // Puffer kommen aus der Arena und werden am Ende der Funktion wieder freigegeben,
+    // generateSafeObstacles ruft das hier bei jedem Versuch auf
+    ArenaScope scope(memoryResource);
+    std::pmr::vector<char> visited(static_cast<size_t>(breite) * hohe, 0, memoryResource);
+    std::pmr::vector<Point> queue(memoryResource);
+    queue.reserve(static_cast<size_t>(breite) * hohe);
+
+    queue.push_back(start);
+    visited[start.y * breite + start.x] = 1;
     int reachableCells = 1;
 
-    while(!queue.empty()) {
-        Point current = queue.front();
-        queue.pop();
+    for(size_t read = 0; read < queue.size(); read++) {
+        Point current = queue[read];
 
         for(const Point& dir : Directions::ALL_DIRECTIONS) {
             Point next = {current.x + dir.x, current.y + dir.y};
 
-            if(grid->isInBounds(next) && !visited[next.y][next.x] &&
+            if(grid->isInBounds(next) && !visited[next.y * breite + next.x] &&
                !grid->isObstacle(next)) {
-                visited[next.y][next.x] = true;
-                queue.push(next);
+                visited[next.y * breite + next.x] = 1;
+                queue.push_back(next);
                 reachableCells++;
             }
         }
@@ -112,12 +117,12 @@ void ObstacleGenerator::generateCenterCross() {
 // 4. ECK-HINDERNISSE
 void ObstacleGenerator::generateCornerObstacles() {
     int size = 3;
-    std::vector<Point> corners = {
+    const std::array<Point, 4> corners = {{
             {2, 2},                    // Oben links
             {breite-2-size, 2},        // Oben rechts
             {2, hohe-2-size},          // Unten links
             {breite-2-size, hohe-2-size}  // Unten rechts
-    };
+    }};
 
     for(const Point& corner : corners) {
         // L-förmiges Hindernis in jeder Ecke
@@ -138,7 +143,7 @@ void ObstacleGenerator::generateMazeWalls(float density) {
                 grid->setCell(x, y, CellType::WALL);
 
                 // Zufällige Verbindung in eine Richtung
-                std::vector<Point> directions = {{0,1}, {1,0}, {0,-1}, {-1,0}};
+                std::array<Point, 4> directions = {{{0,1}, {1,0}, {0,-1}, {-1,0}}};
                 std::shuffle(directions.begin(), directions.end(), rng);
 
                 for(const Point& dir : directions) {
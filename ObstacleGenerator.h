@@ -6,16 +6,24 @@
 #include <vector>
 #include <queue>
 #include <algorithm>
+#include <memory_resource>
 
 class ObstacleGenerator {
 private:
     std::mt19937 rng;
     Grid* grid;
     int breite, hohe;
+    // Herkunft der Suchpuffer (z.B. die Tick-Arena des Spiels)
+    std::pmr::memory_resource* memoryResource = std::pmr::get_default_resource();
 
 public:
     ObstacleGenerator(Grid* g);
 
+    void setMemoryResource(std::pmr::memory_resource* resource) { memoryResource = resource; }
+    // Zufallszustand fuer Snapshots (Levelwechsel nach einem Restore erzeugen dieselben Hindernisse)
+    const std::mt19937& getRng() const { return rng; }
+    void setRng(const std::mt19937& state) { rng = state; }
+
     bool canReachAllAreas(const Point& start);
     void generateRandomObstacles(int count);
     void generateBlocks(int count, int minSize = 2, int maxSize = 4);
@@ -0,0 +1,194 @@
+#include "ParallelBFS.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+
+namespace {
+    [[nodiscard]] inline bool testBit(const std::vector<uint64_t> &bits, int index) {
+        return (bits[index >> 6] >> (index & 63)) & 1;
+    }
+}
+
+bool ParallelBFSPathfinder::findPath(Point start, Point goal, const Grid &grid, const Snake &snake, std::vector<Point> &out) {
+    return search(start, goal, grid, snake, out);
+}
+
+bool ParallelBFSPathfinder::findPath(Point start, Point goal, const Grid &grid, const VirtualSnake &snake, std::vector<Point> &out) {
+    return search(start, goal, grid, snake, out);
+}
+
+template<typename Body>
+size_t ParallelBFSPathfinder::prepare(const Grid &grid, const Body &snake, int startIndex) {
+    breite = grid.getBreite();
+    hohe = grid.getHohe();
+    const size_t cells = static_cast<size_t>(breite) * hohe;
+    const size_t words = (cells + 63) / 64;
+    if (distance.size() != cells) {
+        distance.resize(cells);
+        visited.resize(words);
+        frontierBits.resize(words);
+        nextBits.resize(words);
+        frontier.reserve(cells);
+    }
+    if (!pool) {
+        pool = std::make_unique<ThreadPool>(threadCount);
+        localQueues.resize(pool->size());
+    }
+    localCounts.assign(pool->size(), 0);
+
+    // Jeder Worker baut ganze 64er-Woerter auf: Wand, Body und die Reste hinter der letzten Zelle
+    // gelten als besucht, damit bottom-up sie gar nicht erst anschaut
+    const CellType *data = grid.data();
+    pool->parallelFor(words, CHUNK_WORDS, [&](size_t begin, size_t end, unsigned worker) {
+        size_t free = 0;
+        std::fill(distance.begin() + static_cast<long>(begin * 64),
+                  distance.begin() + static_cast<long>(std::min(end * 64, cells)), -1);
+        for (size_t w = begin; w < end; w++) {
+            uint64_t bits = 0;
+            for (size_t j = 0; j < 64; j++) {
+                const size_t i = w * 64 + j;
+                if (i >= cells) {
+                    bits |= ~uint64_t{0} << j;
+                    break;
+                }
+                if (data[i] == CellType::WALL || snake.blocksIndex(static_cast<int>(i))) {
+                    bits |= uint64_t{1} << j;
+                } else {
+                    free++;
+                }
+            }
+            visited[w] = bits;
+        }
+        localCounts[worker] += free;
+    });
+
+    size_t unvisited = 0;
+    for (size_t count : localCounts) unvisited += count;
+    const uint64_t startMask = uint64_t{1} << (startIndex & 63);
+    if (!(visited[startIndex >> 6] & startMask)) {
+        unvisited--;
+    }
+    visited[startIndex >> 6] |= startMask;
+    distance[startIndex] = 0;
+    return unvisited;
+}
+
+void ParallelBFSPathfinder::stepTopDown(int level) {
+    pool->parallelFor(frontier.size(), CHUNK_NODES, [&](size_t begin, size_t end, unsigned worker) {
+        std::vector<int> &queue = localQueues[worker];
+        // Wer das Bit zuerst setzt, bekommt die Zelle; die anderen sehen es schon gesetzt
+        auto claim = [&](int v) {
+            const uint64_t mask = uint64_t{1} << (v & 63);
+            std::atomic_ref<uint64_t> word(visited[v >> 6]);
+            if ((word.load(std::memory_order_relaxed) & mask) || (word.fetch_or(mask, std::memory_order_relaxed) & mask)) {
+                return;
+            }
+            distance[v] = level + 1;
+            queue.push_back(v);
+        };
+        for (size_t k = begin; k < end; k++) {
+            const int u = frontier[k];
+            const int x = u % breite;
+            const int y = u / breite;
+            if (y > 0) claim(u - breite);
+            if (y < hohe - 1) claim(u + breite);
+            if (x > 0) claim(u - 1);
+            if (x < breite - 1) claim(u + 1);
+        }
+    });
+}
+
+void ParallelBFSPathfinder::stepBottomUp(int level) {
+    pool->parallelFor(visited.size(), CHUNK_WORDS, [&](size_t begin, size_t end, unsigned worker) {
+        std::vector<int> &queue = localQueues[worker];
+        for (size_t w = begin; w < end; w++) {
+            uint64_t open = ~visited[w];
+            uint64_t found = 0;
+            while (open) {
+                const int j = std::countr_zero(open);
+                open &= open - 1;
+                const int v = static_cast<int>(w * 64) + j;
+                const int x = v % breite;
+                const int y = v / breite;
+                if ((y > 0 && testBit(frontierBits, v - breite)) || (y < hohe - 1 && testBit(frontierBits, v + breite))
+                    || (x > 0 && testBit(frontierBits, v - 1)) || (x < breite - 1 && testBit(frontierBits, v + 1))) {
+                    found |= uint64_t{1} << j;
+                    distance[v] = level + 1;
+                    queue.push_back(v);
+                }
+            }
+            // Nur eigene Woerter schreiben, die Front der naechsten Ebene gleich als Bitfeld
+            nextBits[w] = found;
+            visited[w] |= found;
+        }
+    });
+    std::swap(frontierBits, nextBits);
+}
+
+void ParallelBFSPathfinder::gatherFrontier() {
+    frontier.clear();
+    for (std::vector<int> &queue : localQueues) {
+        frontier.insert(frontier.end(), queue.begin(), queue.end());
+        queue.clear();
+    }
+}
+
+void ParallelBFSPathfinder::buildPath(int goalIndex, std::vector<Point> &out) const {
+    // Rueckwaerts vom Ziel: der erste Nachbar mit Distanz - 1 ist ein Vorgaenger auf einem kuerzesten Weg
+    out.resize(distance[goalIndex]);
+    int current = goalIndex;
+    for (int k = distance[goalIndex]; k > 0; k--) {
+        out[k - 1] = Point(current % breite, current / breite);
+        const int x = current % breite;
+        const int y = current / breite;
+        if (y > 0 && distance[current - breite] == k - 1) current -= breite;
+        else if (y < hohe - 1 && distance[current + breite] == k - 1) current += breite;
+        else if (x > 0 && distance[current - 1] == k - 1) current -= 1;
+        else current += 1;
+    }
+}
+
+template<typename Body>
+bool ParallelBFSPathfinder::search(Point start, Point goal, const Grid &grid, const Body &snake, std::vector<Point> &out) {
+    out.clear();
+    if (!grid.isInBounds(start) || !grid.isInBounds(goal)) {
+        return false;
+    }
+    const int w = grid.getBreite();
+    const int startIndex = start.y * w + start.x;
+    const int goalIndex = goal.y * w + goal.x;
+    const size_t cells = static_cast<size_t>(w) * grid.getHohe();
+    if (cells < PARALLEL_MIN_CELLS) {
+        return SearchKernels::withGridPolicy(grid, start, [&](const auto &policy) {
+            return SearchKernels::bfs(policy, grid.data(), snake, startIndex, goalIndex, scratch, out);
+        });
+    }
+
+    size_t unvisited = prepare(grid, snake, startIndex);
+    frontier.clear();
+    frontier.push_back(startIndex);
+    bool bottomUp = false;
+    for (int level = 0; !frontier.empty() && distance[goalIndex] < 0; level++) {
+        if (!bottomUp && frontier.size() * ALPHA > unvisited) {
+            // Front ist gross: ab jetzt suchen die unbesuchten Zellen ihre Eltern
+            bottomUp = true;
+            std::fill(frontierBits.begin(), frontierBits.end(), 0);
+            for (int v : frontier) frontierBits[v >> 6] |= uint64_t{1} << (v & 63);
+        } else if (bottomUp && frontier.size() * BETA < cells) {
+            bottomUp = false;
+        }
+        scratch.expanded += frontier.size();
+        if (bottomUp) {
+            stepBottomUp(level);
+        } else {
+            stepTopDown(level);
+        }
+        gatherFrontier();
+        unvisited -= frontier.size();
+    }
+    if (distance[goalIndex] < 0) {
+        return false;
+    }
+    buildPath(goalIndex, out);
+    return true;
+}
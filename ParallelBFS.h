@@ -0,0 +1,63 @@
+#ifndef SNAKEGAME_PARALLELBFS_H
+#define SNAKEGAME_PARALLELBFS_H
+
+#include "Pathfinder.h"
+#include "ThreadPool.h"
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+// Ebenenweise BFS auf dem Thread-Pool fuer einzelne Anfragen auf riesigen Grids.
+// Top-down: die Front wird auf die Worker verteilt, jeder sammelt die neu entdeckten Zellen in
+// seiner eigenen Queue, "besucht" ist ein Bitfeld, das per atomarem fetch_or beansprucht wird.
+// Bottom-up: wird die Front gross, prueft stattdessen jede unbesuchte Zelle, ob ein Nachbar im
+// Front-Bitfeld liegt; jeder Worker schreibt dabei nur eigene 64er-Woerter, ganz ohne Atomics.
+// Umgeschaltet wird nach Frontgroesse (wie bei Beamer et al.). Die Distanzen sind dieselben wie bei
+// BFSPathfinder, der Pfad geht vom Ziel aus immer zum ersten Nachbarn mit Distanz - 1.
+// Kleine Grids (das normale Spielfeld) laufen ueber die serielle BFS, der Pool startet erst bei Bedarf.
+class ParallelBFSPathfinder : public Pathfinder {
+public:
+    // threads = Worker inklusive Aufrufer, 0 = Hardware-Threads
+    explicit ParallelBFSPathfinder(unsigned threads = 0) : threadCount(threads) {}
+
+    using Pathfinder::findPath;
+    bool findPath(Point start, Point goal, const Grid &grid, const Snake &snake, std::vector<Point> &out) override;
+    bool findPath(Point start, Point goal, const Grid &grid, const VirtualSnake &snake, std::vector<Point> &out) override;
+
+    // Parallel erst ab so vielen Zellen, darunter kostet das Aufwecken der Worker mehr als es bringt
+    static constexpr size_t PARALLEL_MIN_CELLS = 1 << 16;
+
+private:
+    // Umschalten: bottom-up, wenn Front * ALPHA > unbesuchte Zellen; zurueck, wenn Front * BETA < Zellen
+    static constexpr size_t ALPHA = 14;
+    static constexpr size_t BETA = 24;
+    // Blockgroessen fuer parallelFor: Frontzellen (top-down) bzw. 64er-Woerter (bottom-up)
+    static constexpr size_t CHUNK_NODES = 1024;
+    static constexpr size_t CHUNK_WORDS = 64;
+
+    unsigned threadCount;
+    std::unique_ptr<ThreadPool> pool;
+
+    int breite = 0;
+    int hohe = 0;
+    std::vector<int> distance;              // Schritte vom Start, -1 = nicht erreicht
+    std::vector<uint64_t> visited;          // 1 = besucht oder blockiert (Wand/Body)
+    std::vector<uint64_t> frontierBits;     // aktuelle Front (nur bottom-up)
+    std::vector<uint64_t> nextBits;         // naechste Front (nur bottom-up)
+    std::vector<int> frontier;
+    std::vector<std::vector<int>> localQueues;  // neu entdeckte Zellen pro Worker
+    std::vector<size_t> localCounts;            // freie Zellen pro Worker beim Aufbau
+
+    template<typename Body>
+    bool search(Point start, Point goal, const Grid &grid, const Body &snake, std::vector<Point> &out);
+    // Bitfeld und Distanzen fuer eine neue Suche aufbauen, Rueckgabe: freie Zellen ohne Start
+    template<typename Body>
+    size_t prepare(const Grid &grid, const Body &snake, int startIndex);
+    void stepTopDown(int level);
+    void stepBottomUp(int level);
+    // Lokale Queues zur neuen Front zusammenfuegen
+    void gatherFrontier();
+    void buildPath(int goalIndex, std::vector<Point> &out) const;
+};
+
+#endif //SNAKEGAME_PARALLELBFS_H
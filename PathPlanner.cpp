@@ -0,0 +1,70 @@
+#include "PathPlanner.h"
+#include "Log.h"
+
+PathPlanner::PathPlanner(int breite, int hohe) : lookahead(breite, hohe) {
+    // Einmal auf die maximale Pfadlaenge, danach allokiert plan() nicht mehr
+    scratchPath.reserve(static_cast<size_t>(breite) * hohe);
+    foodCandidates.reserve(FOOD_CANDIDATES);
+}
+
+void PathPlanner::plan(Pathfinder &pathfinder, const Grid &grid, const Snake &snake, FoodIndex &food,
+                       std::vector<Point> &out) {
+    out.clear();
+    const Point start = snake.getHeadPosition();
+    const Point goal = food.nearest(start);
+
+    // DEBUG: Ausgabe der Positionen (0 UP,1 DOWN, 2 LEFT, 3 RIGHT, 4 NONE)
+    SNAKE_LOG_DEBUG("Snake Head: (%d,%d)", start.x, start.y);
+    SNAKE_LOG_DEBUG("Target Food: (%d,%d)", goal.x, goal.y);
+    SNAKE_LOG_DEBUG("Snake Direction: %d", static_cast<int>(snake.getDirection()));
+
+    if (goal.x == -1 && goal.y == -1) {
+        return;
+    }
+
+    // Berechne neuen Pfad direkt in den wiederverwendeten Puffer (keine Allokation nach dem Aufwaermen)
+    bool found = pathfinder.findPath(start, goal, grid, snake, out);
+
+    // Naechstes Essen eingesperrt: die naechsten paar Essen der Reihe nach probieren
+    if (!found && food.size() > 1) {
+        food.nearest(start, FOOD_CANDIDATES, foodCandidates);
+        for (const Point &candidate : foodCandidates) {
+            if (candidate != goal && pathfinder.findPath(start, candidate, grid, snake, out)) {
+                SNAKE_LOG_DEBUG("Nearest food unreachable, using (%d,%d)", candidate.x, candidate.y);
+                break;
+            }
+        }
+    }
+
+    // DEBUG: Pfad-Informationen
+    SNAKE_LOG_DEBUG("Path points found: %zu", out.size());
+    if (!out.empty()) {
+        SNAKE_LOG_DEBUG("First path point: (%d,%d)", out[0].x, out[0].y);
+    }
+
+    // Vorausschau: nach dem Fressen muss der Schwanz noch erreichbar sein, sonst dem Schwanz folgen
+    if (!out.empty() && !leavesTailReachable(pathfinder, grid, snake, out)) {
+        bool tailFound = pathfinder.findPath(start, snake.getTailPosition(), grid, snake, scratchPath);
+        SNAKE_LOG_DEBUG("Path to food traps the snake, tail path: %zu", scratchPath.size());
+        if (tailFound && !scratchPath.empty()) {
+            out.swap(scratchPath);
+        }
+    }
+}
+
+bool PathPlanner::leavesTailReachable(Pathfinder &pathfinder, const Grid &grid, const Snake &snake,
+                                      const std::vector<Point> &pathPoints) {
+    lookahead.reset(snake, grid);
+    for (const Point& p : pathPoints) {
+        lookahead.apply(p);
+    }
+
+    bool reachable = lookahead.getLength() <= 1;
+    if (!reachable) {
+        // Zweite Suche auf dem simulierten Zustand: vom Essen zurueck zum eigenen Schwanz
+        reachable = pathfinder.findPath(lookahead.getHeadPosition(), lookahead.getTailPosition(), grid, lookahead, scratchPath);
+    }
+
+    lookahead.rollbackAll();
+    return reachable;
+}
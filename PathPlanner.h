@@ -0,0 +1,33 @@
+#ifndef SNAKEGAME_PATHPLANNER_H
+#define SNAKEGAME_PATHPLANNER_H
+
+#include "Pathfinder.h"
+#include "FoodIndex.h"
+#include "VirtualSnake.h"
+#include <vector>
+
+// Die AutoPlay-Planung eines Ticks ohne Game: Weg zum naechsten Essen, bei eingesperrtem Essen
+// die naechsten FOOD_CANDIDATES der Reihe nach, danach die Schwanz-Vorausschau (fuehrt der Weg
+// in eine Falle, wird stattdessen dem Schwanz gefolgt). Haelt nur wiederverwendete Puffer, so
+// fahren das Spiel und der Hintergrund-Planer (SpeculativePlanner) dieselbe Logik auf eigenen Daten.
+class PathPlanner {
+public:
+    static constexpr size_t FOOD_CANDIDATES = 4;  // so viele Essen werden hoechstens angesteuert
+
+    PathPlanner(int breite, int hohe);
+
+    // Schreibt den Pfad (ohne Kopf) in out, leer wenn es keinen gibt. Die Puffer werden
+    // getauscht statt kopiert, out sollte also wie die internen Puffer breite*hohe reserviert haben
+    void plan(Pathfinder &pathfinder, const Grid &grid, const Snake &snake, FoodIndex &food, std::vector<Point> &out);
+
+    // Simuliert den Pfad und prueft, ob der Schwanz danach noch erreichbar ist
+    bool leavesTailReachable(Pathfinder &pathfinder, const Grid &grid, const Snake &snake,
+                             const std::vector<Point> &pathPoints);
+
+private:
+    VirtualSnake lookahead;                 // simuliert den Pfad, ohne Snake/Grid zu kopieren
+    std::vector<Point> scratchPath;         // Zusatzsuchen (Schwanz)
+    std::vector<Point> foodCandidates;      // naechste Essen, falls das naechste nicht erreichbar ist
+};
+
+#endif //SNAKEGAME_PATHPLANNER_H
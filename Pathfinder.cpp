@@ -1,52 +1,22 @@
 #include "Pathfinder.h"
+#include "DistanceField.h"
+#include "HierarchicalPathfinder.h"
+#include "DStarLite.h"
+#include "ParallelBFS.h"
 
-std::vector<Point> Pathfinder::getNeighbors(const Point &p, const Grid &grid, const Snake &snake) const {
-    std::vector<Point> neighbors;
-    neighbors.reserve(Directions::ALL_DIRECTIONS.size());
-
-    for (const Point &dir : Directions::ALL_DIRECTIONS) {
-        Point candidate = p + dir;  // absolute neighbor
-
-        // PRUFE, ob im Grid und kein Wand
-        if(grid.isInBounds(candidate) && grid.getCell(candidate) != CellType::WALL){
-            //PRUFE, ob es keinen Teil vom Schlangen Körper (außer den Schwanz von der Schlange)
-            bool isSnakeBody = false;
-            const std::deque<Point> &snakeBody = snake.getBody();
-
-            //SKIPPE die Prüfung vom letzte Teil der Schlange(Schwanz),weil es sich bewegt
-            size_t checkUntil = snakeBody.size();
-            if (checkUntil > 1){
-                // Nur SKIPPE der Schwanz Prüfung, wenn die Schlange sich nicht vergrößert
-                checkUntil -= 1;
-            }
-            for (size_t i = 0; i < checkUntil; i++) {
-                if (snakeBody[i] == candidate){
-                    isSnakeBody = true;
-                    break;
-                }
-            }
-            if (!isSnakeBody){
-                neighbors.push_back(candidate);
-            }
-        }
-    }
-    return neighbors;
-}
-
-std::vector<Direction> Pathfinder::pathToDirections(const std::vector<Point> &path, Point startpos)const{
-    std::vector<Direction> directions;
-
-    if (path.empty()) {
-        return directions;
-    }
-
+void Pathfinder::pathToDirections(const std::vector<Point> &path, Point startpos, std::vector<Direction> &out) const {
+    out.clear();
     Point current = startpos;
 
     for (const auto &next : path) {
-        directions.push_back(getDirection(current,next));
+        out.push_back(getDirection(current,next));
         current = next;
     }
+}
 
+std::vector<Direction> Pathfinder::pathToDirections(const std::vector<Point> &path, Point startpos)const{
+    std::vector<Direction> directions;
+    pathToDirections(path, startpos, directions);
     return directions;
 }
 
@@ -59,129 +29,79 @@ Direction Pathfinder::getDirection(const Point &from, const Point &to) const {
     return Direction::NONE;
 }
 
-// BFS Pathfinder Implementation
-std::vector<Point> BFSPathfinder::findPath(Point start, Point goal, const Grid& grid, const Snake& snake) {
-    std::queue<Point> queue;
-    std::unordered_set<Point, PointHash> visited;
-    std::unordered_map<Point, Point, PointHash> cameFrom;
-
-    // Start von den kopf der snake
-    queue.push(start);
-    visited.insert(start);
-
-    bool foundPath = false;
-
-    while (!queue.empty() && !foundPath) {
-        Point current = queue.front();
-        queue.pop();
-
-        // Check if den goal erreicht haben
-        if (current == goal) {
-            foundPath = true;
-            break;
-        }
-
-        // Get (up, down, left, right)
-        std::vector<Point> neighbors = getNeighbors(current, grid, snake);
-
-        for (const auto& neighbor : neighbors) {
-            if (visited.find(neighbor) == visited.end()) {
-                queue.push(neighbor);
-                visited.insert(neighbor);
-                cameFrom[neighbor] = current;
-            }
-        }
-    }
-
-    // Wenn wir einen Pfad gefunden haben, rekonstruieren wir ihn
+std::vector<Point> Pathfinder::findPath(Point start, Point goal, const Grid &grid, const Snake &snake) {
     std::vector<Point> path;
-    if (foundPath) {
-        Point current = goal;
-        while (current != start) {
-            path.push_back(current);
-            current = cameFrom[current];
-        }
-
-        // Kehren Sie den Pfad um, um vom Start zum Ziel zu gelangen
-        std::reverse(path.begin(), path.end());
-    }
-
+    findPath(start, goal, grid, snake, path);
     return path;
 }
 
-// Dijkstra Pathfinder Implementierung
-std::vector<Point> DijkstraPathfinder::findPath(Point start, Point goal, const Grid& grid, const Snake& snake) {
-    // Priority queue fuer Dijkstra's algorithm
-    using PQElement = std::pair<int, Point>;
-    std::priority_queue<PQElement, std::vector<PQElement>, std::greater<PQElement>> pq;
-
-    // Datenstrukturen verfolgen
-    std::unordered_map<Point, int, PointHash> distance;
-    std::unordered_map<Point, Point, PointHash> cameFrom;
-    std::unordered_set<Point, PointHash> visited;
-
-    // Initialisieren Sie Entfernungen bis unendlich (Max von int !!)
-    for (int y = 0; y < grid.getHohe(); y++) {
-        for (int x = 0; x < grid.getBreite(); x++) {
-            Point p(x, y);
-            distance[p] = std::numeric_limits<int>::max();
-        }
-    }
-
-    // Start Knote hat 0 Entfernung
-    distance[start] = 0;
-    pq.push(std::make_pair(0, start));
-
-    bool foundPath = false;
-
-    while (!pq.empty() && !foundPath) {
-        // Knoten mit minimaler Distanz abrufen
-        Point current = pq.top().second;
-        pq.pop();
+std::vector<Point> Pathfinder::findPath(Point start, Point goal, const Grid &grid, const VirtualSnake &snake) {
+    std::vector<Point> path;
+    findPath(start, goal, grid, snake, path);
+    return path;
+}
 
-        // Überspringen, wenn bereits besucht
-        if (visited.find(current) != visited.end()) {
-            continue;
-        }
+// BFS Pathfinder Implementation
+bool BFSPathfinder::findPath(Point start, Point goal, const Grid& grid, const Snake& snake, std::vector<Point>& out) {
+    return search(start, goal, grid, snake, out);
+}
 
-        // Als besucht markieren
-        visited.insert(current);
+bool BFSPathfinder::findPath(Point start, Point goal, const Grid& grid, const VirtualSnake& snake, std::vector<Point>& out) {
+    return search(start, goal, grid, snake, out);
+}
 
-        // Prüfen, ob wir das Ziel erreicht haben
-        if (current == goal) {
-            foundPath = true;
-            break;
-        }
+template<typename Body>
+bool BFSPathfinder::search(Point start, Point goal, const Grid& grid, const Body& snake, std::vector<Point>& out) {
+    out.clear();
+    if (!grid.isInBounds(start) || !grid.isInBounds(goal)) {
+        return false;
+    }
+    const int breite = grid.getBreite();
+    return SearchKernels::withGridPolicy(grid, start, [&](const auto &policy) {
+        return SearchKernels::bfs(policy, grid.data(), snake,
+                                  start.y * breite + start.x, goal.y * breite + goal.x, scratch, out);
+    });
+}
 
-        // Nachbarn verarbeiten
-        std::vector<Point> neighbors = getNeighbors(current, grid, snake);
+// Dijkstra Pathfinder Implementierung
+bool DijkstraPathfinder::findPath(Point start, Point goal, const Grid& grid, const Snake& snake, std::vector<Point>& out) {
+    syncClearance(grid, snake);
+    return search(start, goal, grid, snake, CellCost{clearance.costs()}, out);
+}
 
-        for (const auto& neighbor : neighbors) {
-            // Die Kosten für den Umzug zum Nachbarn betragen in dieser Implementierung immer 1
-            int newDist = distance[current] + 1;
+bool DijkstraPathfinder::findPath(Point start, Point goal, const Grid& grid, const VirtualSnake& snake, std::vector<Point>& out) {
+    return search(start, goal, grid, snake, UnitCost{}, out);
+}
 
-            if (newDist < distance[neighbor]) {
-                distance[neighbor] = newDist;
-                cameFrom[neighbor] = current;
-                pq.push(std::make_pair(newDist, neighbor));
-            }
+void DijkstraPathfinder::syncClearance(const Grid& grid, const Snake& snake) {
+    const Snake::MoveDelta &delta = snake.getLastMove();
+    const bool sameBoard = clearance.isValid() && clearance.getBreite() == grid.getBreite()
+                           && clearance.getHohe() == grid.getHohe();
+    if (sameBoard && &snake == trackedSnake && delta.epoch == seenEpoch && delta.moveCount - seenMoves <= 1) {
+        if (delta.moveCount != seenMoves) {
+            // Genau ein Zug: nur um den neuen Kopf und den frei gewordenen Schwanz neu rechnen
+            clearance.update(grid, snake, delta.enteredIndex);
+            clearance.update(grid, snake, delta.vacatedIndex);
         }
+    } else {
+        clearance.build(grid, snake);
     }
+    trackedSnake = &snake;
+    seenMoves = delta.moveCount;
+    seenEpoch = delta.epoch;
+}
 
-    // Wenn wir einen Pfad gefunden haben, rekonstruieren wir ihn
-    std::vector<Point> path;
-    if (foundPath) {
-        Point current = goal;
-        while (current != start) {
-            path.push_back(current);
-            current = cameFrom[current];
-        }
-
-        // Kehren Sie den Pfad um, um vom Start zum Ziel zu gelangen
-        std::reverse(path.begin(), path.end());
+template<typename Body, class Cost>
+bool DijkstraPathfinder::search(Point start, Point goal, const Grid& grid, const Body& snake, const Cost& cost, std::vector<Point>& out) {
+    out.clear();
+    if (!grid.isInBounds(start) || !grid.isInBounds(goal)) {
+        return false;
     }
-
-    return path;
+    const int breite = grid.getBreite();
+    return SearchKernels::withGridPolicy(grid, start, [&](const auto &policy) {
+        return SearchKernels::dijkstra(policy, grid.data(), snake,
+                                       start.y * breite + start.x, goal.y * breite + goal.x, scratch, out, cost);
+    });
 }
 
 std::unique_ptr<Pathfinder> Pathfinder::create(Pathfinder::Algorithm algo) {
@@ -192,8 +112,20 @@ std::unique_ptr<Pathfinder> Pathfinder::create(Pathfinder::Algorithm algo) {
         case Algorithm::DIJKSTRA:
             return std::make_unique<DijkstraPathfinder>();
 
+        case Algorithm::DISTANCE_FIELD:
+            return std::make_unique<DistanceFieldPathfinder>();
+
+        case Algorithm::HIERARCHICAL:
+            return std::make_unique<HierarchicalPathfinder>();
+
+        case Algorithm::DSTAR_LITE:
+            return std::make_unique<DStarLitePathfinder>();
+
+        case Algorithm::PARALLEL_BFS:
+            return std::make_unique<ParallelBFSPathfinder>();
+
         default:
             // Fallback, falls nötig
             return std::make_unique<BFSPathfinder>();
     }
-}
\ No newline at end of file
+}
@@ -2,12 +2,18 @@
 #define SNAKEGAME_PATHFINDER_H
 
 #include "Snake.h"
+#include "VirtualSnake.h"
+#include "SearchKernels.h"
+#include "ClearanceMap.h"
 #include <functional>
 #include <vector>
 #include <queue>
 #include <unordered_map>
 #include <unordered_set>
+#include <limits>
+#include <algorithm>
 #include <memory>
+#include <cstdint>
 
 // Funktor zum Berechnen eines Hash-Werts für Objekte vom Typ Point,
 // damit sie z.B. in std::unordered_map oder std::unordered_set verwendet werden können.
@@ -17,32 +23,82 @@ struct PointHash{
     }
 };
 class Pathfinder{
-public:
-    //
-    std::vector<Point> getNeighbors(const Point &p, const Grid &grid,const Snake &snake) const;
+protected:
+    // Wiederverwendete Puffer der Suchkerne
+    SearchScratch scratch;
 
+public:
+    // Schreibt die Richtungen in out und nutzt dessen Kapazitaet weiter
+    void pathToDirections(const std::vector<Point> &path, Point startpos, std::vector<Direction> &out) const;
     std::vector<Direction> pathToDirections(const std::vector<Point> &path, Point startpos) const;
 
     Direction getDirection(const Point &from,const Point &to)const;
 
-    virtual std::vector<Point> findPath(Point start, Point goal, const Grid &grid,const Snake &snake) = 0;
+    // Schreibt den Pfad (ohne Start) in out; out wird geleert, die Kapazitaet bleibt erhalten.
+    // Rueckgabe: true, wenn das Ziel erreichbar ist (auch bei start == goal mit leerem Pfad)
+    virtual bool findPath(Point start, Point goal, const Grid &grid, const Snake &snake, std::vector<Point> &out) = 0;
+    // Suche auf einem simulierten Zustand (z.B. "erreiche ich vom Essen aus noch meinen Schwanz?")
+    virtual bool findPath(Point start, Point goal, const Grid &grid, const VirtualSnake &snake, std::vector<Point> &out) = 0;
+
+    // Bequeme Varianten, die einen neuen Vektor zurueckgeben
+    std::vector<Point> findPath(Point start, Point goal, const Grid &grid,const Snake &snake);
+    std::vector<Point> findPath(Point start, Point goal, const Grid &grid,const VirtualSnake &snake);
+
+    // Benachrichtigungen vom Spiel, damit Pathfinder mit Cache (z.B. Entfernungsfeld) nur bei
+    // Aenderungen neu rechnen. Die einfachen Suchen ignorieren sie.
+    virtual void onFoodChanged([[maybe_unused]] const std::vector<Point> &foodPositions) {}
+    virtual void onLevelChanged() {}
+
+    // Expandierte Knoten seit dem letzten Aufruf (fuer die HUD-Statistik), setzt den Zaehler zurueck
+    size_t takeNodesExpanded() {
+        const size_t n = scratch.expanded;
+        scratch.expanded = 0;
+        return n;
+    }
 
     virtual ~Pathfinder() = default;
 
     enum class Algorithm{
         BFS,
-        DIJKSTRA
+        DIJKSTRA,
+        DISTANCE_FIELD,
+        HIERARCHICAL,
+        DSTAR_LITE,
+        PARALLEL_BFS
     };
 
+    // Duenne Laufzeit-Huelle: die Klassen waehlen nur den passenden, zur Compile-Zeit
+    // spezialisierten Suchkern aus SearchKernels.h
     static std::unique_ptr<Pathfinder> create(Algorithm algo);
 };
 
 class BFSPathfinder : public Pathfinder{
-    std::vector<Point> findPath(Point start, Point goal, const Grid &grid,const Snake &snake)override;
+    template<typename Body>
+    bool search(Point start, Point goal, const Grid &grid, const Body &snake, std::vector<Point> &out);
+public:
+    using Pathfinder::findPath;
+    bool findPath(Point start, Point goal, const Grid &grid, const Snake &snake, std::vector<Point> &out)override;
+    bool findPath(Point start, Point goal, const Grid &grid, const VirtualSnake &snake, std::vector<Point> &out)override;
 };
 
+// Dijkstra mit Freiraum-Kosten: Zellen nahe an Wand oder Body kosten mehr (siehe ClearanceMap).
+// Die Karte wird ueber Snake::getLastMove() pro Zug nur um Kopf und Schwanz nachgefuehrt.
+// Suchen auf VirtualSnake (Schwanz-Check) brauchen nur die Erreichbarkeit und laufen mit Kosten 1.
 class DijkstraPathfinder : public Pathfinder{
-    std::vector<Point> findPath(Point start, Point goal, const Grid &grid,const Snake &snake)override;
+    ClearanceMap clearance;
+    const Snake *trackedSnake = nullptr;
+    uint64_t seenMoves = 0;
+    uint32_t seenEpoch = 0;
+
+    void syncClearance(const Grid &grid, const Snake &snake);
+    template<typename Body, class Cost>
+    bool search(Point start, Point goal, const Grid &grid, const Body &snake, const Cost &cost, std::vector<Point> &out);
+public:
+    using Pathfinder::findPath;
+    bool findPath(Point start, Point goal, const Grid &grid, const Snake &snake, std::vector<Point> &out)override;
+    bool findPath(Point start, Point goal, const Grid &grid, const VirtualSnake &snake, std::vector<Point> &out)override;
+
+    void onLevelChanged() override { clearance.invalidate(); }
 };
 
 #endif //SNAKEGAME_PATHFINDER_H
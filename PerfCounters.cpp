@@ -0,0 +1,138 @@
+#include "PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace {
+    const char *const EVENT_NAMES[PerfCounters::EVENT_COUNT] = {
+            "Zyklen", "Instruktionen", "L1d-Misses", "LLC-Misses", "Sprung-Fehlvorhersagen"};
+}
+
+#ifdef __linux__
+
+namespace {
+    struct EventConfig {
+        uint32_t type;
+        uint64_t config;
+    };
+
+    constexpr EventConfig EVENT_CONFIGS[PerfCounters::EVENT_COUNT] = {
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                 | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    };
+
+    int openEvent(const EventConfig &event, int groupFd) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = event.type;
+        attr.config = event.config;
+        // Die Gruppe startet angehalten, Mitglieder folgen dem Anfuehrer
+        attr.disabled = groupFd < 0 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+    }
+}
+
+PerfCounters::PerfCounters() {
+    int firstError = 0;
+    for (int i = 0; i < EVENT_COUNT; i++) {
+        fds[i] = openEvent(EVENT_CONFIGS[i], leader);
+        if (fds[i] < 0) {
+            if (firstError == 0) firstError = errno;
+            continue;
+        }
+        if (leader < 0) leader = fds[i];
+    }
+    if (leader < 0) {
+        reason = std::string("perf_event_open: ") + std::strerror(firstError);
+        if (firstError == EACCES || firstError == EPERM) {
+            reason += " (/proc/sys/kernel/perf_event_paranoid?)";
+        } else if (firstError == ENOENT || firstError == EOPNOTSUPP) {
+            reason += " (keine PMU, z.B. in einer VM)";
+        }
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+void PerfCounters::start() {
+    if (leader >= 0) ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void PerfCounters::stop() {
+    if (leader >= 0) ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void PerfCounters::reset() {
+    if (leader >= 0) ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+}
+
+PerfCounters::Sample PerfCounters::read() const {
+    Sample sample;
+    for (int i = 0; i < EVENT_COUNT; i++) {
+        uint64_t values[3] = {};    // Wert, Zeit aktiviert, Zeit gelaufen
+        if (fds[i] < 0 || ::read(fds[i], values, sizeof(values)) != static_cast<ssize_t>(sizeof(values))) {
+            continue;
+        }
+        if (values[2] == 0) {
+            // Nie auf einen Zaehler gekommen: kein Wert, auch keine 0
+            continue;
+        }
+        sample.value[i] = values[2] < values[1]
+                ? static_cast<uint64_t>(static_cast<double>(values[0]) * values[1] / values[2])
+                : values[0];
+        sample.valid[i] = true;
+    }
+    return sample;
+}
+
+#else
+
+PerfCounters::PerfCounters() : reason("perf_event_open gibt es nur unter Linux") {
+    for (int &fd : fds) fd = -1;
+}
+PerfCounters::~PerfCounters() = default;
+void PerfCounters::start() {}
+void PerfCounters::stop() {}
+void PerfCounters::reset() {}
+PerfCounters::Sample PerfCounters::read() const { return {}; }
+
+#endif
+
+void PerfCounters::print(std::ostream &os, double units, const char *unit) const {
+    if (!available()) {
+        os << "nicht verfuegbar (" << reason << ")";
+        return;
+    }
+    const Sample sample = read();
+    if (units <= 0.0) units = 1.0;
+    bool first = true;
+    for (int i = 0; i < EVENT_COUNT; i++) {
+        if (!sample.valid[i]) continue;
+        os << (first ? "" : ", ") << EVENT_NAMES[i] << "/" << unit << " "
+           << static_cast<double>(sample.value[i]) / units;
+        first = false;
+        if (i == INSTRUCTIONS && sample.valid[CYCLES] && sample.value[CYCLES] > 0) {
+            os << ", IPC " << static_cast<double>(sample.value[INSTRUCTIONS]) / static_cast<double>(sample.value[CYCLES]);
+        }
+    }
+    if (first) {
+        os << "keine Werte (Zaehler nie gelaufen)";
+    }
+}
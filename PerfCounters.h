@@ -0,0 +1,47 @@
+#ifndef SNAKEGAME_PERFCOUNTERS_H
+#define SNAKEGAME_PERFCOUNTERS_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Hardware-Zaehler fuer die Benchmarks ueber Linux perf_event_open: Zyklen, Instruktionen,
+// L1d- und LLC-Misses, falsch vorhergesagte Spruenge. Gezaehlt wird nur der aufrufende Thread
+// im User-Space, und nur zwischen start() und stop() (die Werte summieren sich bis reset()).
+// Ohne Linux, ohne Rechte (perf_event_paranoid) oder in VMs/Containern ohne PMU bleibt
+// available() false und alle Aufrufe tun nichts; einzelne fehlende Ereignisse fallen nur weg.
+class PerfCounters {
+public:
+    enum Event { CYCLES, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, BRANCH_MISSES, EVENT_COUNT };
+
+    struct Sample {
+        uint64_t value[EVENT_COUNT] = {};
+        bool valid[EVENT_COUNT] = {};
+    };
+
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    [[nodiscard]] bool available() const { return leader >= 0; }
+    // Warum nichts gezaehlt wird (leer, wenn available())
+    [[nodiscard]] const std::string &unavailableReason() const { return reason; }
+
+    // Ein ioctl auf die ganze Gruppe, ausserhalb der gemessenen Zeit aufrufen
+    void start();
+    void stop();
+    void reset();
+    // Bei Multiplexing (mehr Ereignisse als Zaehler) hochgerechnet
+    [[nodiscard]] Sample read() const;
+
+    // "Zyklen/Tick ..., IPC ..., ..." fuer die verfuegbaren Ereignisse, pro units Einheiten
+    void print(std::ostream &os, double units, const char *unit) const;
+
+private:
+    int fds[EVENT_COUNT];
+    int leader = -1;
+    std::string reason;
+};
+
+#endif //SNAKEGAME_PERFCOUNTERS_H
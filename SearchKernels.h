@@ -0,0 +1,232 @@
+#ifndef SNAKEGAME_SEARCHKERNELS_H
+#define SNAKEGAME_SEARCHKERNELS_H
+
+#include "grid.h"
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+
+// Such-Puffer, die ueber Ticks hinweg wiederverwendet werden (flach, Index = y * breite + x).
+// "besucht" wird ueber einen Generationszaehler markiert, damit nichts geloescht werden muss.
+struct SearchScratch {
+    int breite = 0;
+    int hohe = 0;
+    std::vector<uint32_t> visitedStamp;
+    uint32_t generation = 0;
+    std::vector<int> cameFrom;
+    std::vector<int> queue;                     // flache FIFO fuer BFS
+    std::vector<int> distance;                  // Dijkstra-Distanzen
+    std::vector<std::pair<int, int>> heap;      // Dijkstra-Heap (Distanz, Zellindex)
+    size_t expanded = 0;                        // expandierte Knoten seit dem letzten Abholen (HUD)
+
+    // Passt die Puffer an die Grid-Groesse an und startet eine neue Suche
+    void begin(int w, int h) {
+        if (w != breite || h != hohe) {
+            breite = w;
+            hohe = h;
+            const size_t cells = static_cast<size_t>(w) * h;
+            visitedStamp.assign(cells, 0);
+            cameFrom.assign(cells, -1);
+            queue.assign(cells, 0);
+            distance.assign(cells, 0);
+            heap.clear();
+            // Jede Zelle kann hoechstens einmal pro Richtung eingefuegt werden
+            heap.reserve(cells * 4);
+            generation = 0;
+        }
+        // Bei Ueberlauf einmal komplett zuruecksetzen
+        if (++generation == 0) {
+            std::fill(visitedStamp.begin(), visitedStamp.end(), 0);
+            generation = 1;
+        }
+    }
+    [[nodiscard]] bool isVisited(int index) const { return visitedStamp[index] == generation; }
+    void markVisited(int index) { visitedStamp[index] = generation; }
+
+    // Rekonstruiert den Pfad (ohne Start) ueber cameFrom in out
+    void buildPath(int startIndex, int goalIndex, std::vector<Point> &out) const {
+        out.clear();
+        for (int current = goalIndex; current != startIndex; current = cameFrom[current]) {
+            out.emplace_back(current % breite, current / breite);
+        }
+        // Kehren Sie den Pfad um, um vom Start zum Ziel zu gelangen
+        std::reverse(out.begin(), out.end());
+    }
+};
+
+// Grid-Policies: legen Breite/Hoehe und die Rand-Garantie zur Compile-Zeit fest.
+// Mit Rand (alle Randzellen sind Wand) braucht die Nachbarexpansion keine Bounds-Checks,
+// mit festen Massen sind auch die Index-Offsets Konstanten.
+template<int W, int H, bool Bordered>
+struct FixedGridPolicy {
+    static constexpr bool bordered = Bordered;
+    static constexpr int width() { return W; }
+    static constexpr int height() { return H; }
+};
+
+template<bool Bordered>
+struct DynamicGridPolicy {
+    static constexpr bool bordered = Bordered;
+    int w;
+    int h;
+    [[nodiscard]] int width() const { return w; }
+    [[nodiscard]] int height() const { return h; }
+};
+
+// Standard-Spielfeld (40x30 mit Rand)
+using StandardBoardPolicy = FixedGridPolicy<40, 30, true>;
+
+// Belegungsquelle ohne Schlange (nur statische Waende)
+struct NoOccupancy {
+    [[nodiscard]] bool blocksIndex(int) const { return false; }
+};
+
+// Schrittkosten fuer Dijkstra (Kosten beim Betreten einer Zelle): ueberall 1 oder aus einer
+// flachen Kostenschicht pro Zelle (z.B. ClearanceMap::costs())
+struct UnitCost {
+    [[nodiscard]] int operator()(int) const { return 1; }
+};
+struct CellCost {
+    const uint8_t *cost;
+    [[nodiscard]] int operator()(int index) const { return cost[index]; }
+};
+
+namespace SearchKernels {
+
+    // Ruft visit(nachbarIndex) fuer alle begehbaren Nachbarn auf, Reihenfolge wie
+    // Directions::ALL_DIRECTIONS (oben, unten, links, rechts), vollstaendig entrollt
+    template<class GridPolicy, class Occupancy, class Visit>
+    inline void expand(const GridPolicy &g, const CellType *cells, const Occupancy &occupancy, int index, Visit &&visit) {
+        const int w = g.width();
+        auto tryCell = [&](int n) {
+            if (cells[n] != CellType::WALL && !occupancy.blocksIndex(n)) {
+                visit(n);
+            }
+        };
+        if constexpr (GridPolicy::bordered) {
+            // Nur Zellen im Inneren werden expandiert, die Nachbarn liegen also immer im Grid
+            tryCell(index - w);
+            tryCell(index + w);
+            tryCell(index - 1);
+            tryCell(index + 1);
+        } else {
+            const int x = index % w;
+            const int y = index / w;
+            if (y > 0) tryCell(index - w);
+            if (y < g.height() - 1) tryCell(index + w);
+            if (x > 0) tryCell(index - 1);
+            if (x < w - 1) tryCell(index + 1);
+        }
+    }
+
+    template<class GridPolicy, class Occupancy>
+    bool bfs(const GridPolicy &g, const CellType *cells, const Occupancy &occupancy,
+             int startIndex, int goalIndex, SearchScratch &s, std::vector<Point> &out) {
+        out.clear();
+        s.begin(g.width(), g.height());
+
+        // Start von den kopf der snake
+        int read = 0;
+        int write = 0;
+        s.queue[write++] = startIndex;
+        s.markVisited(startIndex);
+
+        while (read < write) {
+            const int current = s.queue[read++];
+            s.expanded++;
+
+            // Check if den goal erreicht haben
+            if (current == goalIndex) {
+                s.buildPath(startIndex, goalIndex, out);
+                return true;
+            }
+
+            expand(g, cells, occupancy, current, [&](int neighbor) {
+                if (!s.isVisited(neighbor)) {
+                    s.queue[write++] = neighbor;
+                    s.markVisited(neighbor);
+                    s.cameFrom[neighbor] = current;
+                }
+            });
+        }
+        return false;
+    }
+
+    template<class GridPolicy, class Occupancy, class Cost = UnitCost>
+    bool dijkstra(const GridPolicy &g, const CellType *cells, const Occupancy &occupancy,
+                  int startIndex, int goalIndex, SearchScratch &s, std::vector<Point> &out,
+                  const Cost &stepCost = Cost{}) {
+        out.clear();
+        s.begin(g.width(), g.height());
+        s.heap.clear();
+
+        // Min-Heap ueber (Distanz, Zelle)
+        const auto heapOrder = std::greater<std::pair<int, int>>();
+        // Abgeschlossene Knoten: hohes Bit in distance markiert "bereits besucht"
+        constexpr int SETTLED = 1 << 30;
+        // Entfernungen gelten nur fuer Zellen dieser Generation, der Rest ist "unendlich"
+        auto distanceOf = [&](int index) {
+            return s.isVisited(index) ? (s.distance[index] & ~SETTLED) : std::numeric_limits<int>::max();
+        };
+
+        // Start Knote hat 0 Entfernung
+        s.markVisited(startIndex);
+        s.distance[startIndex] = 0;
+        s.heap.emplace_back(0, startIndex);
+
+        while (!s.heap.empty()) {
+            // Knoten mit minimaler Distanz abrufen
+            std::pop_heap(s.heap.begin(), s.heap.end(), heapOrder);
+            const auto [currentDist, current] = s.heap.back();
+            s.heap.pop_back();
+
+            // Überspringen, wenn bereits besucht (veralteter Heap-Eintrag)
+            if (s.distance[current] & SETTLED) {
+                continue;
+            }
+            s.distance[current] |= SETTLED;
+            s.expanded++;
+
+            // Prüfen, ob wir das Ziel erreicht haben
+            if (current == goalIndex) {
+                s.buildPath(startIndex, goalIndex, out);
+                return true;
+            }
+
+            expand(g, cells, occupancy, current, [&](int neighbor) {
+                // Kosten zum Betreten des Nachbarn (UnitCost: immer 1, dann ist das eine BFS)
+                const int newDist = currentDist + stepCost(neighbor);
+                if (newDist < distanceOf(neighbor)) {
+                    s.markVisited(neighbor);
+                    s.distance[neighbor] = newDist;
+                    s.cameFrom[neighbor] = current;
+                    s.heap.emplace_back(newDist, neighbor);
+                    std::push_heap(s.heap.begin(), s.heap.end(), heapOrder);
+                }
+            });
+        }
+        return false;
+    }
+
+    // Waehlt zur Laufzeit die passende Policy und ruft f(policy) auf:
+    // Standardbrett > beliebiges Grid mit Rand > allgemeiner Fall mit Bounds-Checks.
+    // Ohne Bounds-Checks darf nur aus dem Inneren gestartet werden.
+    template<class F>
+    decltype(auto) withGridPolicy(const Grid &grid, const Point &start, F &&f) {
+        const int w = grid.getBreite();
+        const int h = grid.getHohe();
+        const bool interior = start.x > 0 && start.x < w - 1 && start.y > 0 && start.y < h - 1;
+        if (grid.hasBorder() && interior) {
+            if (w == StandardBoardPolicy::width() && h == StandardBoardPolicy::height()) {
+                return f(StandardBoardPolicy{});
+            }
+            return f(DynamicGridPolicy<true>{w, h});
+        }
+        return f(DynamicGridPolicy<false>{w, h});
+    }
+}
+
+#endif //SNAKEGAME_SEARCHKERNELS_H
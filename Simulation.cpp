@@ -0,0 +1,227 @@
+#include "Simulation.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    constexpr Direction START_DIRECTIONS[] = {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT};
+
+    Simulation::Options withDefaults(Simulation::Options options) {
+        options.snakes = std::max(1, options.snakes);
+        if (options.breite <= 0 || options.hohe <= 0) {
+            const int side = std::max(20, static_cast<int>(std::ceil(std::sqrt(options.snakes * 64.0))));
+            options.breite = side;
+            options.hohe = side;
+        }
+        if (options.foodItems <= 0) {
+            options.foodItems = options.snakes;
+        }
+        if (options.threads == 0) {
+            options.threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        return options;
+    }
+}
+
+Simulation::Simulation(const Options &opts)
+        : options(withDefaults(opts)),
+          grid(options.breite, options.hohe, true),
+          occupancy(static_cast<size_t>(options.breite) * options.hohe, 0),
+          died(options.snakes, 0),
+          rng(options.seed),
+          pool(options.threads),
+          scratch(pool.size()) {
+    // Zufaellige Einzelhindernisse (nur im Inneren, der Rand bleibt geschlossen)
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    for (int y = 1; y < grid.getHohe() - 1; y++) {
+        for (int x = 1; x < grid.getBreite() - 1; x++) {
+            if (chance(rng) < options.obstacleDensity) {
+                grid.setCell(x, y, CellType::WALL);
+            }
+        }
+    }
+
+    std::uniform_int_distribution<int> direction(0, 3);
+    agents.reserve(options.snakes);
+    for (int i = 0; i < options.snakes; i++) {
+        int cell = randomFreeCell();
+        if (cell < 0) {
+            std::cerr << "Simulation: kein Platz fuer Schlange " << i << ", Grid zu klein\n";
+            break;
+        }
+        agents.push_back(Agent{Snake(Point(cell % grid.getBreite(), cell / grid.getBreite()),
+                                     grid.getBreite(), grid.getHohe(),
+                                     START_DIRECTIONS[direction(rng)],
+                                     options.maxSnakeLength, &occupancy)});
+    }
+    for (int i = 0; i < options.foodItems; i++) {
+        spawnFood();
+    }
+}
+
+int Simulation::randomFreeCell() {
+    std::uniform_int_distribution<int> distx(1, grid.getBreite() - 2);
+    std::uniform_int_distribution<int> disty(1, grid.getHohe() - 2);
+    const int attempts = 4 * grid.getBreite() * grid.getHohe();
+    for (int i = 0; i < attempts; i++) {
+        const int x = distx(rng);
+        const int y = disty(rng);
+        const int index = y * grid.getBreite() + x;
+        if (grid.getCell(x, y) == CellType::EMPTY && occupancy[index] == 0) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+void Simulation::spawnFood() {
+    const int cell = randomFreeCell();
+    if (cell >= 0) {
+        grid.setCell(cell % grid.getBreite(), cell / grid.getBreite(), CellType::FOOD);
+    }
+}
+
+Direction Simulation::plan(const Snake &snake, SearchScratch &s) const {
+    const int breite = grid.getBreite();
+    const Point head = snake.getHeadPosition();
+    const int headIndex = head.y * breite + head.x;
+    const CellType *cells = grid.data();
+    const SharedOccupancy blocked{occupancy.data()};
+
+    // Begrenzte BFS bis zum naechsten Essen, nur lesend auf Grid und Belegung
+    const int target = SearchKernels::withGridPolicy(grid, head, [&](const auto &policy) {
+        s.begin(breite, grid.getHohe());
+        int read = 0;
+        int write = 0;
+        s.queue[write++] = headIndex;
+        s.markVisited(headIndex);
+        while (read < write && read < PLAN_BUDGET) {
+            const int current = s.queue[read++];
+            if (current != headIndex && cells[current] == CellType::FOOD) {
+                return current;
+            }
+            SearchKernels::expand(policy, cells, blocked, current, [&](int neighbor) {
+                if (!s.isVisited(neighbor)) {
+                    s.markVisited(neighbor);
+                    s.cameFrom[neighbor] = current;
+                    s.queue[write++] = neighbor;
+                }
+            });
+        }
+        // Kein Essen in Reichweite: die am weitesten entfernte erreichte Zelle ansteuern (Platz suchen)
+        return write > 1 ? s.queue[write - 1] : -1;
+    });
+    if (target < 0) {
+        return snake.getDirection();
+    }
+
+    // Zurueck bis zum ersten Schritt nach dem Kopf
+    int step = target;
+    while (s.cameFrom[step] != headIndex) {
+        step = s.cameFrom[step];
+    }
+    const int delta = step - headIndex;
+    if (delta == -breite) return Direction::UP;
+    if (delta == breite) return Direction::DOWN;
+    if (delta == -1) return Direction::LEFT;
+    return Direction::RIGHT;
+}
+
+void Simulation::tick() {
+    // Phase 1: parallel planen, jede Schlange schreibt nur ihr eigenes planned
+    pool.parallelFor(agents.size(), 64, [this](size_t begin, size_t end, unsigned worker) {
+        SearchScratch &s = scratch[worker];
+        for (size_t i = begin; i < end; i++) {
+            agents[i].planned = plan(agents[i].snake, s);
+        }
+    });
+
+    // Phase 2: seriell und in fester Reihenfolge aufloesen
+    for (Agent &agent : agents) {
+        agent.snake.setDirection(agent.planned);
+        agent.snake.move();
+    }
+    // Erst nach allen Zuegen pruefen, damit Frontalzusammenstoesse beide treffen
+    for (size_t i = 0; i < agents.size(); i++) {
+        const Snake &snake = agents[i].snake;
+        died[i] = snake.checkWallCollision(grid) || snake.checkSelfCollision();
+    }
+    for (size_t i = 0; i < agents.size(); i++) {
+        if (died[i]) continue;
+        Snake &snake = agents[i].snake;
+        const Point head = snake.getHeadPosition();
+        if (grid.getCell(head) == CellType::FOOD) {
+            snake.grow();
+            grid.setCell(head, CellType::EMPTY);
+            foodEaten++;
+            spawnFood();
+        }
+    }
+    std::uniform_int_distribution<int> direction(0, 3);
+    for (size_t i = 0; i < agents.size(); i++) {
+        if (!died[i]) continue;
+        deaths++;
+        const int cell = randomFreeCell();
+        if (cell >= 0) {
+            agents[i].snake.respawn(Point(cell % grid.getBreite(), cell / grid.getBreite()),
+                                    START_DIRECTIONS[direction(rng)]);
+        }
+    }
+    ticks++;
+}
+
+uint64_t Simulation::checksum() const {
+    uint64_t hash = 1469598103934665603ULL;
+    for (const Agent &agent : agents) {
+        const Point head = agent.snake.getHeadPosition();
+        for (uint64_t value : {static_cast<uint64_t>(head.x), static_cast<uint64_t>(head.y),
+                               static_cast<uint64_t>(agent.snake.getLength())}) {
+            hash = (hash ^ value) * 1099511628211ULL;
+        }
+    }
+    return (hash ^ deaths ^ (foodEaten << 32)) * 1099511628211ULL;
+}
+
+int Simulation::runBenchmark(const Options &opts, int ticks) {
+    using Clock = std::chrono::steady_clock;
+    const Options options = withDefaults(opts);
+    std::vector<unsigned> threadCounts;
+    for (unsigned t = 1; t < options.threads; t *= 2) {
+        threadCounts.push_back(t);
+    }
+    threadCounts.push_back(options.threads);
+
+    std::cout << "Simulation: " << options.snakes << " Schlangen auf " << options.breite << "x" << options.hohe
+              << ", " << ticks << " Ticks\n";
+
+    double baseline = 0.0;
+    uint64_t referenceChecksum = 0;
+    bool deterministic = true;
+    for (unsigned threads : threadCounts) {
+        Options run = options;
+        run.threads = threads;
+        Simulation sim(run);
+
+        const auto start = Clock::now();
+        for (int i = 0; i < ticks; i++) {
+            sim.tick();
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        const double ticksPerSecond = seconds > 0.0 ? ticks / seconds : 0.0;
+        if (baseline == 0.0) {
+            baseline = ticksPerSecond;
+            referenceChecksum = sim.checksum();
+        } else if (sim.checksum() != referenceChecksum) {
+            deterministic = false;
+        }
+
+        std::cout << "  Threads " << threads << ": " << ticksPerSecond << " Ticks/s (x"
+                  << (baseline > 0.0 ? ticksPerSecond / baseline : 0.0) << "), Tode: " << sim.getDeaths()
+                  << ", Essen: " << sim.getFoodEaten() << "\n";
+    }
+
+    std::cout << (deterministic ? "OK: gleiches Ergebnis fuer jede Thread-Anzahl\n"
+                                : "FEHLER: Ergebnis haengt von der Thread-Anzahl ab\n");
+    return deterministic ? 0 : 1;
+}
@@ -0,0 +1,78 @@
+#ifndef SNAKEGAME_SIMULATION_H
+#define SNAKEGAME_SIMULATION_H
+
+#include "grid.h"
+#include "Snake.h"
+#include "SearchKernels.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Headless Stresstest: viele KI-Schlangen auf einem gemeinsamen Grid.
+// Jeder Tick hat zwei Phasen:
+//  1. Planen (parallel): jede Schlange sucht gegen den unveraenderten Zustand des Ticks
+//     (Grid + gemeinsame Belegung werden in dieser Phase nur gelesen) ihren naechsten Zug.
+//  2. Aufloesen (seriell, feste Reihenfolge): alle ziehen, dann Kollisionen, Essen, Respawn.
+// Das Ergebnis ist damit unabhaengig von der Thread-Anzahl.
+class Simulation {
+public:
+    struct Options {
+        int snakes = 1000;
+        int breite = 0;                 // 0 = aus der Schlangenanzahl ableiten (~64 Zellen pro Schlange)
+        int hohe = 0;
+        int foodItems = 0;              // 0 = eine pro Schlange
+        size_t maxSnakeLength = 64;     // maximale Laenge pro Schlange (Segmente), danach waechst sie nicht mehr
+        unsigned threads = 0;           // 0 = Hardware-Threads
+        unsigned seed = 12345;
+        double obstacleDensity = 0.03;  // Anteil zufaelliger Wandzellen
+    };
+
+    explicit Simulation(const Options &options);
+
+    void tick();
+
+    [[nodiscard]] uint64_t getTicks() const { return ticks; }
+    [[nodiscard]] uint64_t getDeaths() const { return deaths; }
+    [[nodiscard]] uint64_t getFoodEaten() const { return foodEaten; }
+    [[nodiscard]] const Grid &getGrid() const { return grid; }
+    // Pruefsumme ueber alle Koepfe und Laengen (gleich fuer jede Thread-Anzahl)
+    [[nodiscard]] uint64_t checksum() const;
+
+    // Misst Ticks/s fuer 1, 2, 4, ... bis maxThreads Threads und prueft die Determinismus
+    static int runBenchmark(const Options &options, int ticks);
+
+private:
+    // Begrenzte BFS pro Schlange und Tick (expandierte Zellen)
+    static constexpr int PLAN_BUDGET = 512;
+
+    struct Agent {
+        Snake snake;
+        Direction planned = Direction::NONE;
+    };
+
+    // Belegungsquelle fuer die Suchkerne: jede belegte Zelle blockiert
+    struct SharedOccupancy {
+        const uint8_t *counts;
+        [[nodiscard]] bool blocksIndex(int index) const { return counts[index] != 0; }
+    };
+
+    Options options;
+    Grid grid;
+    std::vector<uint8_t> occupancy;     // gemeinsame Belegung aller Schlangen
+    std::vector<Agent> agents;
+    std::vector<uint8_t> died;          // pro Tick: Schlange ist gestorben
+    std::mt19937 rng;
+    ThreadPool pool;
+    std::vector<SearchScratch> scratch; // Such-Puffer pro Worker-Thread, nicht pro Schlange
+
+    uint64_t ticks = 0;
+    uint64_t deaths = 0;
+    uint64_t foodEaten = 0;
+
+    [[nodiscard]] Direction plan(const Snake &snake, SearchScratch &s) const;
+    [[nodiscard]] int randomFreeCell();
+    void spawnFood();
+};
+
+#endif //SNAKEGAME_SIMULATION_H
@@ -0,0 +1,154 @@
+#include "SlicedSearch.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+namespace {
+    // Die BFS laeuft vom Ziel zum Kopf, der Kopf selbst ist Body und muss trotzdem betretbar sein
+    struct ExceptHead {
+        const Snake &snake;
+        int head;
+        [[nodiscard]] bool blocksIndex(int index) const { return index != head && snake.blocksIndex(index); }
+    };
+}
+
+void SlicedSearch::start(const Grid &grid, Point target) {
+    scratch.begin(grid.getBreite(), grid.getHohe());
+    goal = target;
+    goalIndex = target.y * grid.getBreite() + target.x;
+    read = 0;
+    write = 0;
+    slices = 0;
+    nearest = target;
+    // Ein Weg hat hoechstens so viele Schritte wie das Grid Zellen, nur der erste start() allokiert
+    followed.reserve(static_cast<size_t>(grid.getBreite()) * grid.getHohe());
+    followed.clear();
+    followedHead = -1;
+    if (!grid.isInBounds(target)) {
+        state = Status::NO_PATH;
+        return;
+    }
+    scratch.queue[write++] = goalIndex;
+    scratch.markVisited(goalIndex);
+    scratch.cameFrom[goalIndex] = -1;
+    state = Status::RUNNING;
+}
+
+SlicedSearch::Status SlicedSearch::step(const Grid &grid, const Snake &snake, const Budget &budget) {
+    if (state != Status::RUNNING) {
+        return state;
+    }
+    slices++;
+    return SearchKernels::withGridPolicy(grid, goal, [&](const auto &policy) {
+        return expandSlice(policy, grid, snake, budget);
+    });
+}
+
+template<class GridPolicy>
+SlicedSearch::Status SlicedSearch::expandSlice(const GridPolicy &g, const Grid &grid, const Snake &snake,
+                                               const Budget &budget) {
+    using Clock = std::chrono::steady_clock;
+    const Point head = snake.getHeadPosition();
+    if (!grid.isInBounds(head)) {
+        return state = Status::NO_PATH;
+    }
+    const int headIndex = head.y * g.width() + head.x;
+    // Die Schlange ist in den bisherigen Baum gelaufen: fertig ohne weitere Expansion
+    if (scratch.isVisited(headIndex)) {
+        return state = Status::FOUND;
+    }
+
+    // Der Kopf ist seit dem letzten Aufruf weitergelaufen: Abstand der gemerkten Zelle neu bestimmen
+    nearestDistance = std::abs(nearest.x - head.x) + std::abs(nearest.y - head.y);
+
+    const ExceptHead occupancy{snake, headIndex};
+    const CellType *cells = grid.data();
+    const size_t nodeLimit = budget.nodes > 0 ? budget.nodes : std::numeric_limits<size_t>::max();
+    const auto deadline = Clock::now() + budget.time;
+    bool reached = false;
+    size_t expanded = 0;
+    while (read < write && !reached) {
+        if (expanded >= nodeLimit) {
+            return state;
+        }
+        if (budget.time.count() > 0 && expanded % TIME_CHECK_INTERVAL == TIME_CHECK_INTERVAL - 1
+            && Clock::now() >= deadline) {
+            return state;
+        }
+        const int current = scratch.queue[read++];
+        expanded++;
+        scratch.expanded++;
+        SearchKernels::expand(g, cells, occupancy, current, [&](int neighbor) {
+            if (!scratch.isVisited(neighbor)) {
+                scratch.queue[write++] = neighbor;
+                scratch.markVisited(neighbor);
+                scratch.cameFrom[neighbor] = current;
+                if (neighbor == headIndex) reached = true;
+                const Point p(neighbor % g.width(), neighbor / g.width());
+                const int distance = std::abs(p.x - head.x) + std::abs(p.y - head.y);
+                if (distance < nearestDistance) {
+                    nearestDistance = distance;
+                    nearest = p;
+                }
+            }
+        });
+    }
+    return state = reached ? Status::FOUND : Status::NO_PATH;
+}
+
+bool SlicedSearch::pathFrom(const Grid &grid, const Snake &snake, Point head, std::vector<Point> &out) const {
+    out.clear();
+    if (state == Status::IDLE || !grid.isInBounds(head)) {
+        return false;
+    }
+    const int breite = grid.getBreite();
+    const CellType *cells = grid.data();
+    int index = head.y * breite + head.x;
+    if (!scratch.isVisited(index)) {
+        return false;
+    }
+    while (index != goalIndex) {
+        index = scratch.cameFrom[index];
+        // Seit der Expansion in den Weg gelaufen? Dann taugt der Baum hier nicht mehr
+        if (cells[index] == CellType::WALL || (index != goalIndex && snake.blocksIndex(index))) {
+            out.clear();
+            return false;
+        }
+        out.emplace_back(index % breite, index / breite);
+    }
+    return true;
+}
+
+bool SlicedSearch::followPath(const Grid &grid, const Snake &snake, Point head) {
+    if (state != Status::FOUND || !grid.isInBounds(head)) {
+        return false;
+    }
+    const int headIndex = head.y * grid.getBreite() + head.x;
+    if (headIndex != followedHead) {
+        if (!followed.empty() && followed.back() == head) {
+            // Einen Schritt auf dem Weg gegangen
+            followed.pop_back();
+        } else {
+            // Erster Aufruf oder vom Weg abgewichen: ab dem Kopf neu lesen (prueft den ganzen Weg)
+            followedHead = -1;
+            if (!pathFrom(grid, snake, head, followed)) {
+                followed.clear();
+                return false;
+            }
+            std::reverse(followed.begin(), followed.end());
+        }
+        followedHead = headIndex;
+    }
+    if (followed.empty()) {
+        return false;
+    }
+    // Nur der naechste Schritt muss jetzt frei sein, alles dahinter wird geprueft, wenn es dran ist
+    const Point next = followed.back();
+    const int nextIndex = next.y * grid.getBreite() + next.x;
+    if (grid.data()[nextIndex] == CellType::WALL || (nextIndex != goalIndex && snake.blocksIndex(nextIndex))) {
+        followed.clear();
+        followedHead = -1;
+        return false;
+    }
+    return true;
+}
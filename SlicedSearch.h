@@ -0,0 +1,85 @@
+#ifndef SNAKEGAME_SLICEDSEARCH_H
+#define SNAKEGAME_SLICEDSEARCH_H
+
+#include "SearchKernels.h"
+#include "Snake.h"
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+// Fortsetzbare Suche mit Budget pro Aufruf, damit ein Tick auf riesigen Grids nicht laenger
+// als ein Frame dauert. Gesucht wird rueckwaerts: eine BFS vom Ziel (Essen) aus, bis sie den
+// Kopf erreicht. Der Suchbaum haengt so nur am Ziel und bleibt gueltig, waehrend die Schlange
+// weiterlaeuft; jede Zelle im Baum kennt ihren kuerzesten Weg zum Ziel (ueber cameFrom).
+// Die Belegung wird bei der Expansion abgefragt, also jeweils im Zustand dieses Aufrufs.
+// pathFrom() prueft den fertigen Weg deshalb noch einmal gegen die aktuelle Schlange,
+// followPath() pro Tick nur den jeweils naechsten Schritt.
+class SlicedSearch {
+public:
+    enum class Status { IDLE, RUNNING, FOUND, NO_PATH };
+
+    // 0 = kein Limit; das Zeitlimit wird alle TIME_CHECK_INTERVAL Knoten geprueft
+    struct Budget {
+        size_t nodes = 0;
+        std::chrono::microseconds time{0};
+        [[nodiscard]] bool unlimited() const { return nodes == 0 && time.count() == 0; }
+    };
+
+    // Neue Suche zum Ziel (verwirft die alte)
+    void start(const Grid &grid, Point goal);
+    void cancel() { state = Status::IDLE; }
+    // Ziel aufgeben (z.B. Weg inzwischen blockiert), zaehlt danach wie NO_PATH
+    void abandon() { if (state != Status::IDLE) state = Status::NO_PATH; }
+
+    // Expandiert hoechstens bis zum Budget. FOUND, sobald head im Baum liegt (auch ohne Expansion,
+    // wenn die Schlange inzwischen in den Baum gelaufen ist), NO_PATH, wenn die Front leer ist
+    Status step(const Grid &grid, const Snake &snake, const Budget &budget);
+
+    // Weg von head zum Ziel (ohne head), O(Weglaenge). false, wenn head nicht im Baum liegt oder
+    // der Weg inzwischen durch den Body fuehrt
+    bool pathFrom(const Grid &grid, const Snake &snake, Point head, std::vector<Point> &out) const;
+
+    // Fuer das Spiel pro Tick (nur bei FOUND): der Weg wird einmal aus dem Baum gelesen, danach
+    // faellt nur der gegangene Schritt weg und der naechste wird geprueft, O(1) pro Tick. Steht der
+    // Kopf nicht mehr auf dem Weg (z.B. MoveSafety ist ausgewichen), wird ab dem Kopf neu gelesen.
+    // false, wenn head nicht im Baum liegt oder der naechste Schritt blockiert ist
+    bool followPath(const Grid &grid, const Snake &snake, Point head);
+    // Weg aus followPath() rueckwaerts: Ziel vorne, back() ist der naechste Schritt
+    [[nodiscard]] const std::vector<Point> &path() const { return followed; }
+
+    // Teilantwort solange RUNNING: die Zelle des Baums, die dem Kopf am naechsten liegt (Manhattan).
+    // Wird beim Einreihen mitgefuehrt, statt am Ende die ganze Front abzusuchen
+    [[nodiscard]] Point nearestCell() const { return nearest; }
+
+    [[nodiscard]] Status status() const { return state; }
+    [[nodiscard]] Point getGoal() const { return goal; }
+    // Wie viele Aufrufe die aktuelle Suche bisher gebraucht hat
+    [[nodiscard]] int sliceCount() const { return slices; }
+
+    // Expandierte Knoten seit dem letzten Aufruf (HUD), setzt den Zaehler zurueck
+    size_t takeNodesExpanded() {
+        const size_t n = scratch.expanded;
+        scratch.expanded = 0;
+        return n;
+    }
+
+private:
+    static constexpr size_t TIME_CHECK_INTERVAL = 256;
+
+    SearchScratch scratch;      // visitedStamp/cameFrom/queue, queue ist die BFS-Front
+    Status state = Status::IDLE;
+    Point goal{-1, -1};
+    int goalIndex = -1;
+    int read = 0;               // Front = queue[read, write)
+    int write = 0;
+    int slices = 0;
+    Point nearest{-1, -1};
+    int nearestDistance = 0;
+    std::vector<Point> followed;    // Weg fuer followPath(), rueckwaerts
+    int followedHead = -1;          // Kopf-Zellindex, fuer den followed gilt (-1 = noch nicht gelesen)
+
+    template<class GridPolicy>
+    Status expandSlice(const GridPolicy &g, const Grid &grid, const Snake &snake, const Budget &budget);
+};
+
+#endif //SNAKEGAME_SLICEDSEARCH_H
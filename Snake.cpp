@@ -1,10 +1,74 @@
 #include "Snake.h"
+#include <algorithm>
 
-Snake::Snake(Point startPosition, Direction startDirection) : currentDirection(startDirection), shouldGrow(false) {
-    body.clear();
-    body.push_back(startPosition);
+namespace {
+    // Naechste Zweierpotenz >= n
+    size_t nextPowerOfTwo(size_t n){
+        size_t capacity = 1;
+        while (capacity < n){
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+}
+
+Snake::Snake(Point startPosition, int breite, int hohe, Direction startDirection)
+        : Snake(startPosition, breite, hohe, startDirection, static_cast<size_t>(breite) * hohe, nullptr) {
+}
+
+Snake::Snake(Point startPosition, int breite, int hohe, Direction startDirection,
+             size_t maxLength, std::vector<uint8_t> *sharedOccupancy)
+        : ring(nextPowerOfTwo(maxLength + 1), 0),
+          mask(ring.size() - 1),
+          headSlot(0),
+          length(1),
+          maxLength(std::max<size_t>(1, maxLength)),
+          occupancy(sharedOccupancy ? 0 : static_cast<size_t>(breite) * hohe, 0),
+          sharedOccupancy(sharedOccupancy),
+          breite(breite),
+          hohe(hohe),
+          leftGrid(false),
+          currentDirection(startDirection),
+          shouldGrow(false) {
+    ring[headSlot] = toIndex(startPosition);
+    ++counts()[ring[headSlot]];
+}
+
+void Snake::respawn(Point startPosition, Direction startDirection){
+    uint8_t *count = counts();
+    for (size_t i = 0; i < length; i++){
+        --count[slotIndex(i)];
+    }
+    headSlot = 0;
+    length = 1;
+    leftGrid = false;
+    shouldGrow = false;
+    currentDirection = startDirection;
+    ring[headSlot] = toIndex(startPosition);
+    ++count[ring[headSlot]];
+    lastMove = {lastMove.moveCount, lastMove.epoch + 1, -1, -1};
+}
+void Snake::restore(const uint32_t *indices, size_t bodyLength, Direction direction, bool growing){
+    uint8_t *count = counts();
+    for (size_t i = 0; i < length; i++){
+        --count[slotIndex(i)];
+    }
+    // Kopf liegt im Ring hinten, der Schwanz in Slot 0
+    length = std::min(bodyLength, maxLength);
+    headSlot = length - 1;
+    for (size_t i = 0; i < length; i++){
+        ring[headSlot - i] = static_cast<int>(indices[i]);
+        ++count[indices[i]];
+    }
+    leftGrid = false;
+    shouldGrow = growing;
+    currentDirection = direction;
+    lastMove = {lastMove.moveCount, lastMove.epoch + 1, -1, -1};
 }
 void Snake::move(){
+    if (leftGrid){
+        return;
+    }
     //GET Kopf aktulle Position
     Point newhead = getHeadPosition();
 
@@ -26,15 +90,30 @@ void Snake::move(){
         //
             return;
     }
-    //ADD Kopf Position in den Body
-    body.push_front(newhead);
+    // Ausserhalb des Grids gibt es keinen Zellindex, das Spiel endet ueber checkWallCollision
+    if (newhead.x < 0 || newhead.x >= breite || newhead.y < 0 || newhead.y >= hohe){
+        leftGrid = true;
+        outsideHead = newhead;
+        return;
+    }
 
-    //REMOVE Snake schwanz(letzten Kopf Position) aus dem Body
-    if (!shouldGrow){
-        body.pop_back();
-    }else{
-        shouldGrow = false;
+    //REMOVE Snake schwanz(letzten Kopf Position) zuerst, damit der Kopf in die frei werdende Zelle darf
+    uint8_t *count = counts();
+    lastMove.vacatedIndex = -1;
+    if (!shouldGrow || length >= maxLength){
+        lastMove.vacatedIndex = slotIndex(length - 1);
+        --count[lastMove.vacatedIndex];
+        --length;
     }
+    shouldGrow = false;
+
+    //ADD Kopf Position in den Body
+    headSlot = (headSlot + 1) & mask;
+    ring[headSlot] = toIndex(newhead);
+    ++count[ring[headSlot]];
+    ++length;
+    lastMove.enteredIndex = ring[headSlot];
+    lastMove.moveCount++;
 }
 
 void Snake::grow(){
@@ -43,41 +122,56 @@ void Snake::grow(){
 
 void Snake::setDirection(Direction newdir){
     //verhindern, dass sich der Snake in einer Richtung drehen kann, in der er sich selbst bewegt, also(180 grad Rotation verhindern)
-    if (currentDirection == Direction::UP && newdir == Direction::DOWN
-    || currentDirection == Direction::DOWN && newdir == Direction::UP
-    || currentDirection == Direction::LEFT && newdir == Direction::RIGHT
-    || currentDirection == Direction::RIGHT && newdir == Direction::LEFT){
+    if ((currentDirection == Direction::UP && newdir == Direction::DOWN)
+    || (currentDirection == Direction::DOWN && newdir == Direction::UP)
+    || (currentDirection == Direction::LEFT && newdir == Direction::RIGHT)
+    || (currentDirection == Direction::RIGHT && newdir == Direction::LEFT)){
         return;
     }
     currentDirection = newdir;
 }
 
+bool Snake::occupies(const Point &p) const{
+    if (p.x < 0 || p.x >= breite || p.y < 0 || p.y >= hohe){
+        return false;
+    }
+    return counts()[toIndex(p)] != 0;
+}
+
+int Snake::countAt(const Point &p) const{
+    if (p.x < 0 || p.x >= breite || p.y < 0 || p.y >= hohe){
+        return 0;
+    }
+    return counts()[toIndex(p)];
+}
+
+bool Snake::blocksCell(const Point &p) const{
+    if (p.x < 0 || p.x >= breite || p.y < 0 || p.y >= hohe){
+        return false;
+    }
+    //SKIPPE den Schwanz, weil er sich bewegt (ausser er liegt doppelt, z.B. direkt nach dem Start)
+    return blocksIndex(toIndex(p));
+}
+
 bool Snake::checkWallCollision(const Grid &grid) const{
+    if (leftGrid){
+        return true;
+    }
     Point head = getHeadPosition();
     return grid.getCell(head) == CellType::WALL;
 }
 
 bool Snake::checkSelfCollision() const{
-    if (body.size() <= 1){
+    if (leftGrid || length <= 1){
         return false;
     }
-
-    Point head = getHeadPosition();
-    auto it = body.begin();
-        ++it;
-    //itrieren durch den Body und pruefen, ob der Kopf die gleiche Point ist wie ein Bodyteil
-    while(it != body.end()){
-        if (*it == head){
-            return true;
-        }
-        ++it;
-    }
-    return false;
+    //Kopf teilt sich die Zelle mit einem Bodyteil
+    return counts()[slotIndex(0)] > 1;
 }
 
 //render die Snake
 void Snake::draw(Grid &grid) const{
-    for (const Point &currentBodyPoint : body){
-        grid.setCell(currentBodyPoint,CellType::SNAKE_BODY);
+    for (size_t i = 0; i < length; i++){
+        grid.setCell(toPoint(slotIndex(i)),CellType::SNAKE_BODY);
     }
-}
\ No newline at end of file
+}
@@ -1,15 +1,91 @@
 #pragma once
-#include <deque>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
 #include "common.h"
 #include "grid.h"
 
 class Snake{
+public:
+    // Was der letzte move() an der Belegung geaendert hat, fuer inkrementelle Planer.
+    // moveCount zaehlt die Zuege; respawn/restore erhoehen epoch, dann taugt das Delta nicht mehr
+    struct MoveDelta{
+        uint64_t moveCount = 0;
+        uint32_t epoch = 0;
+        int enteredIndex = -1;      // neue Kopfzelle
+        int vacatedIndex = -1;      // freigewordene Schwanzzelle (-1 beim Wachsen)
+    };
+
 private:
-    std::deque<Point> body;
+    // Body als Ringpuffer mit gepackten Zellindizes (y * breite + x).
+    // Die Kapazitaet ist eine Zweierpotenz, damit der Ringindex nur maskiert werden muss.
+    std::vector<int> ring;
+    size_t mask;
+    size_t headSlot;    // Position des Kopfes im Ring
+    size_t length;      // Anzahl der Segmente
+    size_t maxLength;   // harte Obergrenze fuer length (der Ring ist auf die Zweierpotenz aufgerundet)
+
+    // Belegungsgrid: Anzahl der Segmente pro Zelle (>1 am Kopf = Selbstkollision)
+    std::vector<uint8_t> occupancy;
+    // Optional gemeinsames Belegungsgrid mehrerer Schlangen (dann bleibt occupancy leer)
+    std::vector<uint8_t> *sharedOccupancy;
+    int breite;
+    int hohe;
+
+    // Kopf hat das Grid verlassen (nur ohne Rand moeglich)
+    bool leftGrid;
+    Point outsideHead;
+
     Direction currentDirection;
     bool shouldGrow;
+    MoveDelta lastMove;
+
+    [[nodiscard]] int toIndex(const Point &p) const { return p.y * breite + p.x; }
+    [[nodiscard]] Point toPoint(int index) const { return {index % breite, index / breite}; }
+    [[nodiscard]] int slotIndex(size_t i) const { return ring[(headSlot - i) & mask]; }
+    [[nodiscard]] const uint8_t *counts() const { return sharedOccupancy ? sharedOccupancy->data() : occupancy.data(); }
+    [[nodiscard]] uint8_t *counts() { return sharedOccupancy ? sharedOccupancy->data() : occupancy.data(); }
+
 public:
-    Snake(Point startPosition, Direction startDirection = Direction::RIGHT);
+    // Leichtgewichtige Sicht auf den Body (Kopf zuerst), liefert Points ohne Kopie
+    class BodyView{
+    private:
+        const Snake *snake;
+    public:
+        class iterator{
+        private:
+            const Snake *snake;
+            size_t i;
+        public:
+            iterator(const Snake *s, size_t i) : snake(s), i(i){}
+            Point operator*() const { return snake->toPoint(snake->slotIndex(i)); }
+            iterator& operator++(){ ++i; return *this; }
+            bool operator!=(const iterator &other) const { return i != other.i; }
+            bool operator==(const iterator &other) const { return i == other.i; }
+        };
+
+        explicit BodyView(const Snake *s) : snake(s){}
+        [[nodiscard]] iterator begin() const { return {snake, 0}; }
+        [[nodiscard]] iterator end() const { return {snake, snake->length}; }
+        [[nodiscard]] size_t size() const { return snake->length; }
+        [[nodiscard]] bool empty() const { return snake->length == 0; }
+        [[nodiscard]] Point operator[](size_t i) const { return snake->toPoint(snake->slotIndex(i)); }
+        [[nodiscard]] Point front() const { return (*this)[0]; }
+        [[nodiscard]] Point back() const { return (*this)[snake->length - 1]; }
+    };
+
+    Snake(Point startPosition, int breite, int hohe, Direction startDirection = Direction::RIGHT);
+    // Fuer viele Schlangen auf einem Grid: die Schlange wird hoechstens maxLength Segmente lang
+    // (danach laeuft der Schwanz auch beim Fressen mit) und die Belegung wird
+    // in sharedOccupancy mitgezaehlt. occupies() und checkSelfCollision() gelten dann fuer alle
+    // Schlangen darauf (Kopf trifft irgendeinen Body).
+    Snake(Point startPosition, int breite, int hohe, Direction startDirection,
+          size_t maxLength, std::vector<uint8_t> *sharedOccupancy);
+
+    // Body aus der Belegung entfernen und als Laenge 1 neu aufsetzen
+    void respawn(Point startPosition, Direction startDirection);
+    // Body aus gepackten Zellindizes (Kopf zuerst) wiederherstellen, z.B. aus einem Snapshot
+    void restore(const uint32_t *indices, size_t bodyLength, Direction direction, bool growing);
 
     // Bewegung und Kontrolle
     void move();
@@ -17,9 +93,27 @@ public:
     void setDirection(Direction dir);
 
     // Status getters
-    [[nodiscard]] Point getHeadPosition() const{return body.front();};
-    [[nodiscard]] const std::deque<Point>& getBody() const{return body;};
+    [[nodiscard]] Point getHeadPosition() const{return leftGrid ? outsideHead : toPoint(slotIndex(0));};
+    [[nodiscard]] Point getTailPosition() const{return toPoint(slotIndex(length - 1));};
+    [[nodiscard]] BodyView getBody() const{return BodyView(this);};
+    [[nodiscard]] size_t getLength() const{return length;};
+    [[nodiscard]] bool isGrowing() const{return shouldGrow;};
     [[nodiscard]] Direction getDirection() const{return currentDirection;};
+    [[nodiscard]] const MoveDelta &getLastMove() const{return lastMove;};
+
+    // Belegung in O(1)
+    [[nodiscard]] bool occupies(const Point &p) const;
+    [[nodiscard]] int countAt(const Point &p) const;
+    // Wie occupies, aber der Schwanz zaehlt als frei, weil er sich beim naechsten Zug weiterbewegt
+    [[nodiscard]] bool blocksCell(const Point &p) const;
+
+    // Index-Varianten ohne Bounds-Check fuer die Suchkerne (Index = y * breite + x)
+    [[nodiscard]] int countAtIndex(int index) const { return counts()[index]; }
+    [[nodiscard]] int getTailIndex() const { return slotIndex(length - 1); }
+    [[nodiscard]] bool blocksIndex(int index) const {
+        const uint8_t count = counts()[index];
+        return count != 0 && !(count == 1 && length > 1 && index == getTailIndex());
+    }
 
     //Kollisionen pruefen (wand oder selbst)
     [[nodiscard]] bool checkWallCollision(const Grid &grid) const;
@@ -0,0 +1,141 @@
+#include "Snapshot.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <iostream>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+
+namespace {
+    constexpr char MAGIC[4] = {'S', 'N', 'K', 'S'};
+
+    // Stream-Puffer direkt auf einem festen char-Array, damit die Engine-Streams nicht allokieren
+    class FixedBuffer : public std::streambuf {
+    public:
+        FixedBuffer(char *begin, char *end) {
+            setp(begin, end);
+            setg(begin, begin, end);
+        }
+        [[nodiscard]] const char *written() const { return pptr(); }
+    };
+
+    // Jedes Wort hoechstens 10 Ziffern plus Trenner
+    using EngineText = std::array<char, EngineState::WORDS * 11>;
+}
+
+bool GameSnapshot::saveToFile(const std::string &path) const {
+    FILE *file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Snapshot: " << path << " kann nicht geschrieben werden\n";
+        return false;
+    }
+    const auto size = static_cast<uint32_t>(data.size());
+    bool ok = std::fwrite(MAGIC, 1, sizeof(MAGIC), file) == sizeof(MAGIC)
+              && std::fwrite(&size, sizeof(size), 1, file) == 1
+              && std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    ok = std::fclose(file) == 0 && ok;
+    return ok;
+}
+
+bool GameSnapshot::loadFromFile(const std::string &path) {
+    FILE *file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        std::cerr << "Snapshot: " << path << " kann nicht gelesen werden\n";
+        return false;
+    }
+    char magic[4];
+    uint32_t size = 0;
+    bool ok = std::fread(magic, 1, sizeof(magic), file) == sizeof(magic)
+              && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0
+              && std::fread(&size, sizeof(size), 1, file) == 1;
+    if (ok) {
+        // Die Groesse steht in der Datei selbst: erst gegen den Rest der Datei pruefen, sonst
+        // allokiert eine kaputte Datei vor dem zu kurzen Lesen ggf. Gigabytes
+        const long headerEnd = std::ftell(file);
+        ok = headerEnd >= 0 && std::fseek(file, 0, SEEK_END) == 0;
+        const long fileEnd = ok ? std::ftell(file) : -1;
+        ok = ok && fileEnd >= headerEnd && static_cast<unsigned long>(fileEnd - headerEnd) >= size
+             && std::fseek(file, headerEnd, SEEK_SET) == 0;
+    }
+    if (ok) {
+        data.resize(size);
+        ok = std::fread(data.data(), 1, size, file) == size;
+    }
+    std::fclose(file);
+    if (!ok) {
+        std::cerr << "Snapshot: " << path << " ist keine gueltige Snapshot-Datei\n";
+        data.clear();
+    }
+    return ok;
+}
+
+SnapshotRing::SnapshotRing(size_t capacity, size_t bytesPerSnapshot) : slots(capacity) {
+    for (GameSnapshot &slot : slots) {
+        slot.reserve(bytesPerSnapshot);
+    }
+}
+
+GameSnapshot &SnapshotRing::push() {
+    GameSnapshot &slot = slots[next];
+    next = (next + 1) % slots.size();
+    if (count < slots.size()) {
+        count++;
+    }
+    return slot;
+}
+
+const GameSnapshot *SnapshotRing::fromNewest(size_t stepsBack) const {
+    if (stepsBack >= count) {
+        return nullptr;
+    }
+    return &slots[(next + slots.size() - 1 - stepsBack) % slots.size()];
+}
+
+void SnapshotRing::dropNewest(size_t drop) {
+    drop = std::min(drop, count);
+    next = (next + slots.size() - drop) % slots.size();
+    count -= drop;
+}
+
+const EngineState::Words &EngineState::capture(const std::mt19937 &engine) {
+    if (hasCaptured && engine == captured) {
+        return words;
+    }
+    EngineText text;
+    FixedBuffer buffer(text.data(), text.data() + text.size());
+    std::ostream out(&buffer);
+    out << engine;
+
+    const char *pos = text.data();
+    const char *end = buffer.written();
+    for (uint32_t &word : words) {
+        while (pos < end && *pos == ' ') pos++;
+        const auto result = std::from_chars(pos, end, word);
+        pos = result.ptr;
+    }
+    captured = engine;
+    hasCaptured = true;
+    return words;
+}
+
+bool EngineState::apply(const Words &words, std::mt19937 &engine) {
+    if (words[WORDS - 1] > std::mt19937::state_size) {
+        return false;
+    }
+    EngineText text;
+    char *pos = text.data();
+    for (const uint32_t word : words) {
+        pos = std::to_chars(pos, text.data() + text.size(), word).ptr;
+        *pos++ = ' ';
+    }
+    FixedBuffer buffer(text.data(), pos);
+    std::istream in(&buffer);
+    std::mt19937 parsed;
+    in >> parsed;
+    if (in.fail()) {
+        return false;
+    }
+    engine = parsed;
+    return true;
+}
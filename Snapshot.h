@@ -0,0 +1,118 @@
+#ifndef SNAKEGAME_SNAPSHOT_H
+#define SNAKEGAME_SNAPSHOT_H
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Kompakter Binaer-Blob mit dem kompletten Spielzustand (wird von Game::saveSnapshot gefuellt).
+// Felder werden per memcpy hintereinander geschrieben; nach dem ersten Mal wird der Puffer nur
+// ueberschrieben, ein Snapshot allokiert dann nicht mehr.
+class GameSnapshot {
+public:
+    // Liest die Felder in derselben Reihenfolge wieder aus, false wenn der Blob zu kurz ist
+    class Reader {
+    public:
+        explicit Reader(const GameSnapshot &snapshot) : data(snapshot.data.data()), size(snapshot.data.size()) {}
+
+        template<typename T>
+        bool get(T &value) {
+            static_assert(std::is_trivially_copyable_v<T>, "Snapshot-Felder muessen trivial kopierbar sein");
+            return getBytes(&value, sizeof(T));
+        }
+        bool getBytes(void *out, size_t bytes) {
+            if (bytes > size - pos) return false;
+            std::memcpy(out, data + pos, bytes);
+            pos += bytes;
+            return true;
+        }
+        // Zeiger auf die naechsten bytes (zum Pruefen an Ort und Stelle) und dahinter weiterlesen,
+        // nullptr wenn der Blob zu kurz ist
+        const uint8_t *skip(size_t bytes) {
+            if (bytes > size - pos) return nullptr;
+            const uint8_t *start = data + pos;
+            pos += bytes;
+            return start;
+        }
+        [[nodiscard]] bool atEnd() const { return pos == size; }
+
+    private:
+        const uint8_t *data;
+        size_t size;
+        size_t pos = 0;
+    };
+
+    void clear() { data.clear(); }
+    void reserve(size_t bytes) { data.reserve(bytes); }
+
+    template<typename T>
+    void put(const T &value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Snapshot-Felder muessen trivial kopierbar sein");
+        putBytes(&value, sizeof(T));
+    }
+    void putBytes(const void *in, size_t bytes) {
+        const size_t pos = data.size();
+        data.resize(pos + bytes);
+        std::memcpy(data.data() + pos, in, bytes);
+    }
+
+    [[nodiscard]] size_t size() const { return data.size(); }
+    [[nodiscard]] bool empty() const { return data.empty(); }
+
+    // Datei: "SNKS" | u32 Groesse | Blob
+    bool saveToFile(const std::string &path) const;
+    bool loadFromFile(const std::string &path);
+
+    uint64_t tick = 0;      // Spiel-Tick bei der Aufnahme (nur zur Anzeige)
+
+private:
+    std::vector<uint8_t> data;
+};
+
+// Die letzten capacity Snapshots (einer pro Tick) fuer das Zurueckspulen.
+// Die Puffer werden reihum wiederverwendet.
+class SnapshotRing {
+public:
+    SnapshotRing(size_t capacity, size_t bytesPerSnapshot);
+
+    // Naechster freier Platz (ueberschreibt den aeltesten, wenn voll)
+    GameSnapshot &push();
+    // stepsBack = 0 ist der neueste, nullptr wenn nicht so weit zurueck vorhanden
+    [[nodiscard]] const GameSnapshot *fromNewest(size_t stepsBack) const;
+    // Verwirft die count neuesten (nach dem Zurueckspulen sind sie ungueltig)
+    void dropNewest(size_t count);
+    void clear() { count = 0; }
+
+    [[nodiscard]] size_t size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+
+private:
+    std::vector<GameSnapshot> slots;
+    size_t next = 0;    // naechster Schreibplatz
+    size_t count = 0;
+};
+
+// Zustand einer std::mt19937 als 624 Zustandsworte + Index, je uint32. Der Rohspeicher der Engine
+// haengt von der Standardbibliothek ab (libstdc++: 64-Bit-Worte, 5 KB), die Worte kommen deshalb
+// ueber ihren Textstrom (operator<< / >>) in einen festen Puffer. Das Formatieren kostet einige
+// 10 us, capture() liest die Engine daher nur neu, wenn sie sich seit dem letzten Mal bewegt hat.
+class EngineState {
+public:
+    static constexpr size_t WORDS = std::mt19937::state_size + 1;
+    using Words = std::array<uint32_t, WORDS>;
+
+    [[nodiscard]] const Words &capture(const std::mt19937 &engine);
+    // false, wenn die Worte kein gueltiger Zustand sind (Index ausserhalb), engine bleibt dann unveraendert
+    static bool apply(const Words &words, std::mt19937 &engine);
+
+private:
+    std::mt19937 captured;
+    bool hasCaptured = false;
+    Words words{};
+};
+
+#endif //SNAKEGAME_SNAPSHOT_H
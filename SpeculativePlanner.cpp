@@ -0,0 +1,147 @@
+#include "SpeculativePlanner.h"
+
+SpeculativePlanner::SpeculativePlanner(int breite, int hohe)
+        : grid(breite, hohe, false),
+          snake(Point(breite / 2, hohe / 2), breite, hohe),
+          planner(breite, hohe) {
+    food.reset(breite, hohe);
+    // Ergebnis-Puffer auf die maximale Pfadlaenge, PathPlanner tauscht mit seinem eigenen Puffer
+    const size_t cells = static_cast<size_t>(breite) * hohe;
+    results[0].path.reserve(cells);
+    results[1].path.reserve(cells);
+}
+
+SpeculativePlanner::~SpeculativePlanner() {
+    stop();
+}
+
+void SpeculativePlanner::start() {
+    if (worker.joinable()) {
+        return;
+    }
+    stopping.store(false);
+    busy.store(false);
+    requested.store(0);
+    published.store(0);
+    jobCounter = 0;
+    pendingJob = 0;
+    worker = std::thread(&SpeculativePlanner::workerLoop, this);
+}
+
+void SpeculativePlanner::stop() {
+    if (!worker.joinable()) {
+        return;
+    }
+    stopping.store(true);
+    requested.fetch_add(1, std::memory_order_release);
+    requested.notify_one();
+    worker.join();
+    pendingJob = 0;
+}
+
+bool SpeculativePlanner::submit(const Key &key, Pathfinder::Algorithm algo, uint64_t wallsVersion,
+                                const Grid &source, const Snake &sourceSnake, const FoodIndex &sourceFood) {
+    if (!worker.joinable()) {
+        return false;
+    }
+    // Rechnet der Thread noch (z.B. an einem verworfenen Auftrag), gehoert ihm der Schnappschuss
+    if (busy.load(std::memory_order_acquire)) {
+        skipped++;
+        pendingJob = 0;
+        return false;
+    }
+    // Gleiche Groessen wie beim letzten Mal: die Kopien allokieren nicht
+    grid.copyCellsFrom(source);
+    snake = sourceSnake;
+    // Essen neu einsortieren statt den ganzen Index zu kopieren: O(Essen) statt O(Zellen), und der
+    // eigene Index behaelt seine Kandidaten-Kapazitaet (eine Kopie wuerde sie nicht mitwachsen lassen)
+    food.clear();
+    for (const Point &p : sourceFood.positions()) {
+        food.insert(p);
+    }
+    jobAlgorithm = algo;
+    jobWallsVersion = wallsVersion;
+
+    pendingKey = key;
+    pendingJob = ++jobCounter;
+    busy.store(true, std::memory_order_relaxed);
+    requested.store(pendingJob, std::memory_order_release);
+    requested.notify_one();
+    return true;
+}
+
+bool SpeculativePlanner::take(const Key &key, std::vector<Point> &out) {
+    if (pendingJob == 0) {
+        return false;
+    }
+    const uint64_t job = pendingJob;
+    pendingJob = 0;
+    if (!(key == pendingKey)) {
+        // Zustand ist seit submit() auseinandergelaufen, der Thread rechnet ggf. ins Leere zu Ende
+        discarded++;
+        return false;
+    }
+
+    uint64_t state = published.load(std::memory_order_acquire);
+    if ((state >> 1) < job) {
+        waits++;
+        do {
+            published.wait(state, std::memory_order_acquire);
+            state = published.load(std::memory_order_acquire);
+        } while ((state >> 1) < job);
+    }
+    // Der Puffer bleibt unangetastet, bis der naechste Auftrag in den anderen schreibt
+    const Result &result = results[state & 1];
+    out.assign(result.path.begin(), result.path.end());
+    takenNodes += result.nodes;
+    hits++;
+    return true;
+}
+
+void SpeculativePlanner::workerLoop() {
+    uint64_t seen = 0;
+    while (true) {
+        requested.wait(seen, std::memory_order_acquire);
+        if (stopping.load()) {
+            break;
+        }
+        seen = requested.load(std::memory_order_acquire);
+        runJob(seen);
+    }
+}
+
+void SpeculativePlanner::runJob(uint64_t job) {
+    const size_t index = static_cast<size_t>(jobAlgorithm);
+    if (!pathfinders[index]) {
+        // Nur beim ersten Auftrag je Algorithmus, danach werden die Pathfinder wiederverwendet
+        pathfinders[index] = Pathfinder::create(jobAlgorithm);
+    }
+    Pathfinder &pathfinder = *pathfinders[index];
+
+    // Zwischengespeicherte Daten (Distanzfeld, Cluster, D*-Lite-Werte) auf den Schnappschuss bringen
+    if (&pathfinder != lastPathfinder || jobWallsVersion != seenWallsVersion) {
+        pathfinder.onLevelChanged();
+        pathfinder.onFoodChanged(food.positions());
+        seenFood = food.positions();
+        lastPathfinder = &pathfinder;
+        seenWallsVersion = jobWallsVersion;
+    } else if (food.positions() != seenFood) {
+        pathfinder.onFoodChanged(food.positions());
+        seenFood = food.positions();
+    }
+
+    // Immer in den Puffer, der nicht zuletzt veroeffentlicht wurde
+    const uint64_t slot = (published.load(std::memory_order_relaxed) & 1) ^ 1;
+    Result &result = results[slot];
+    if (food.empty()) {
+        result.path.clear();
+    } else {
+        planner.plan(pathfinder, grid, snake, food, result.path);
+    }
+    result.nodes = pathfinder.takeNodesExpanded();
+
+    // Erst den Schnappschuss freigeben, dann veroeffentlichen: wer das Ergebnis sieht, sieht auch busy == false
+    busy.store(false, std::memory_order_release);
+    published.store((job << 1) | slot, std::memory_order_release);
+    published.notify_all();
+}
@@ -0,0 +1,105 @@
+#ifndef SNAKEGAME_SPECULATIVEPLANNER_H
+#define SNAKEGAME_SPECULATIVEPLANNER_H
+
+#include "PathPlanner.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Plant den Pfad des naechsten Ticks im Hintergrund, sobald der Zug des aktuellen Ticks feststeht.
+// Bis auf Eingaben des Spielers (die den Pfad nicht beeinflussen, nur getNextAIMove) ist der
+// Zustand zu Beginn des naechsten Ticks genau der am Ende dieses Ticks.
+//
+// submit() kopiert Grid, Schlange und Essen in einen Schnappschuss, der Planer-Thread rechnet darauf
+// mit eigenem Pathfinder und eigener PathPlanner-Logik und legt das Ergebnis in einen von zwei
+// Ergebnis-Puffern (immer in den, der nicht zuletzt veroeffentlicht wurde). Veroeffentlicht wird
+// nur ueber Atomics, kein Mutex: published = (Auftrag << 1) | Puffer.
+// take() liefert das Ergebnis nur, wenn der Schluessel (Tick, Zustandsstempel) noch passt, sonst
+// wird es verworfen und der Aufrufer plant selbst. Ist der Thread noch nicht fertig, wartet take().
+class SpeculativePlanner {
+public:
+    // Tick, fuer den geplant wird, und ein Stempel, den Reset/Restore/Algorithmuswechsel erhoehen
+    struct Key {
+        uint64_t tick = 0;
+        uint64_t stamp = 0;
+        bool operator==(const Key &other) const { return tick == other.tick && stamp == other.stamp; }
+    };
+
+    SpeculativePlanner(int breite, int hohe);
+    ~SpeculativePlanner();
+    SpeculativePlanner(const SpeculativePlanner&) = delete;
+    SpeculativePlanner& operator=(const SpeculativePlanner&) = delete;
+
+    // Startet/beendet den Planer-Thread (allokiert, also nicht im eingeschwungenen Tick aufrufen)
+    void start();
+    void stop();
+    [[nodiscard]] bool isRunning() const { return worker.joinable(); }
+
+    // Neuer Auftrag auf einer Kopie des Zustands. wallsVersion aendert sich bei neuen Waenden.
+    // false (und gezaehlt), wenn der Thread noch am letzten Auftrag rechnet
+    bool submit(const Key &key, Pathfinder::Algorithm algo, uint64_t wallsVersion,
+                const Grid &grid, const Snake &snake, const FoodIndex &food);
+
+    // Pfad des Auftrags mit diesem Schluessel nach out (ohne Kopf, ggf. leer). false, wenn es keinen
+    // passenden Auftrag gibt; ein unpassender wird dabei verworfen
+    bool take(const Key &key, std::vector<Point> &out);
+
+    // Vom Planer-Thread expandierte Knoten des zuletzt geholten Ergebnisses (HUD), setzt zurueck
+    size_t takeNodesExpanded() {
+        const size_t n = takenNodes;
+        takenNodes = 0;
+        return n;
+    }
+
+    [[nodiscard]] uint64_t hitCount() const { return hits; }
+    [[nodiscard]] uint64_t discardCount() const { return discarded; }
+    [[nodiscard]] uint64_t skipCount() const { return skipped; }
+    // Wie oft take() auf den Planer-Thread warten musste
+    [[nodiscard]] uint64_t waitCount() const { return waits; }
+
+private:
+    static constexpr size_t ALGORITHM_COUNT = static_cast<size_t>(Pathfinder::Algorithm::PARALLEL_BFS) + 1;
+
+    // Schnappschuss, gehoert zwischen submit() und Ende des Auftrags nur dem Planer-Thread
+    Grid grid;
+    Snake snake;
+    FoodIndex food;
+    Pathfinder::Algorithm jobAlgorithm = Pathfinder::Algorithm::BFS;
+    uint64_t jobWallsVersion = 0;
+
+    struct Result {
+        std::vector<Point> path;
+        size_t nodes = 0;
+    };
+    Result results[2];
+
+    // Nur im Planer-Thread: ein Pathfinder pro Algorithmus (bei Bedarf angelegt) und was er zuletzt sah
+    PathPlanner planner;
+    std::unique_ptr<Pathfinder> pathfinders[ALGORITHM_COUNT];
+    Pathfinder *lastPathfinder = nullptr;
+    uint64_t seenWallsVersion = 0;
+    std::vector<Point> seenFood;
+
+    // Nur im Spiel-Thread
+    Key pendingKey;
+    uint64_t pendingJob = 0;        // 0 = nichts offen
+    uint64_t jobCounter = 0;
+    size_t takenNodes = 0;
+    uint64_t hits = 0;
+    uint64_t discarded = 0;
+    uint64_t skipped = 0;
+    uint64_t waits = 0;
+
+    std::thread worker;
+    std::atomic<uint64_t> requested{0};     // Nummer des letzten Auftrags
+    std::atomic<uint64_t> published{0};     // (Auftrag << 1) | Ergebnis-Puffer
+    std::atomic<bool> busy{false};          // Thread rechnet, der Schnappschuss ist tabu
+    std::atomic<bool> stopping{false};
+
+    void workerLoop();
+    void runJob(uint64_t job);
+};
+
+#endif //SNAKEGAME_SPECULATIVEPLANNER_H
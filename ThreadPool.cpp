@@ -0,0 +1,83 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers.reserve(threads - 1);
+    for (unsigned i = 1; i < threads; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t chunk, const Job &job) {
+    if (count == 0) {
+        return;
+    }
+    chunk = std::max<size_t>(chunk, 1);
+    // Ein Thread oder nur ein Block: direkt ausfuehren, ohne jemanden zu wecken
+    if (workers.empty() || count <= chunk) {
+        job(0, count, 0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentJob = &job;
+        jobCount = count;
+        jobChunk = chunk;
+        nextBegin.store(0, std::memory_order_relaxed);
+        pending = workers.size();
+        ++generation;
+    }
+    wake.notify_all();
+
+    runChunks(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return pending == 0; });
+    currentJob = nullptr;
+}
+
+void ThreadPool::runChunks(unsigned worker) {
+    while (true) {
+        const size_t begin = nextBegin.fetch_add(jobChunk, std::memory_order_relaxed);
+        if (begin >= jobCount) {
+            return;
+        }
+        (*currentJob)(begin, std::min(begin + jobChunk, jobCount), worker);
+    }
+}
+
+void ThreadPool::workerLoop(unsigned index) {
+    uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+
+        runChunks(index);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--pending == 0) {
+            done.notify_one();
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef SNAKEGAME_THREADPOOL_H
+#define SNAKEGAME_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fester Thread-Pool fuer datenparallele Schleifen. Der aufrufende Thread arbeitet als
+// Worker 0 mit, parallelFor() kehrt erst zurueck, wenn alle Bloecke erledigt sind.
+class ThreadPool {
+public:
+    // job(begin, end, worker): bearbeitet [begin, end), worker < size() fuer Puffer pro Thread
+    using Job = std::function<void(size_t, size_t, unsigned)>;
+
+    // threads = Anzahl Worker inklusive Aufrufer, 0 = Hardware-Threads
+    explicit ThreadPool(unsigned threads = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    [[nodiscard]] unsigned size() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+    // Verteilt [0, count) in Bloecken der Groesse chunk auf alle Worker
+    void parallelFor(size_t count, size_t chunk, const Job &job);
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    bool stopping = false;
+    uint64_t generation = 0;        // jede parallelFor-Runde weckt die Worker einmal
+    size_t pending = 0;             // Worker, die in dieser Runde noch arbeiten
+
+    const Job *currentJob = nullptr;
+    size_t jobCount = 0;
+    size_t jobChunk = 1;
+    std::atomic<size_t> nextBegin{0};
+
+    void workerLoop(unsigned index);
+    void runChunks(unsigned worker);
+};
+
+#endif //SNAKEGAME_THREADPOOL_H
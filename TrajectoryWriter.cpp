@@ -0,0 +1,312 @@
+#include "TrajectoryWriter.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    constexpr uint16_t FORMAT_VERSION = 1;
+    constexpr uint8_t METHOD_RAW = 0;
+    constexpr uint8_t METHOD_LZ = 1;
+
+    constexpr size_t MIN_MATCH = 4;
+    constexpr size_t MAX_OFFSET = 65535;
+    constexpr int HASH_BITS = 12;
+
+    void put16(uint8_t *out, uint16_t value) {
+        out[0] = static_cast<uint8_t>(value);
+        out[1] = static_cast<uint8_t>(value >> 8);
+    }
+
+    void put32(uint8_t *out, uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            out[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    uint32_t read32(const uint8_t *in) {
+        uint32_t value;
+        std::memcpy(&value, in, sizeof(value));
+        return value;
+    }
+
+    uint64_t read64(const uint8_t *in) {
+        uint64_t value;
+        std::memcpy(&value, in, sizeof(value));
+        return value;
+    }
+
+    void putVarint(std::vector<uint8_t> &out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    // Laengen >= 15 gehen als Folge von 255ern plus Rest hinter das Token
+    uint8_t *putLength(uint8_t *op, size_t length) {
+        length -= 15;
+        while (length >= 255) {
+            *op++ = 255;
+            length -= 255;
+        }
+        *op++ = static_cast<uint8_t>(length);
+        return op;
+    }
+
+    bool readLength(const uint8_t *&ip, const uint8_t *end, size_t &length) {
+        uint8_t next;
+        do {
+            if (ip >= end) return false;
+            next = *ip++;
+            length += next;
+        } while (next == 255);
+        return true;
+    }
+
+    uint8_t *putSequence(uint8_t *op, const uint8_t *literals, size_t literalLength, size_t offset, size_t matchLength) {
+        const size_t matchCode = matchLength ? matchLength - MIN_MATCH : 0;
+        uint8_t *token = op++;
+        *token = static_cast<uint8_t>((literalLength < 15 ? literalLength : 15) << 4);
+        if (literalLength >= 15) op = putLength(op, literalLength);
+        std::memcpy(op, literals, literalLength);
+        op += literalLength;
+        if (matchLength == 0) {
+            return op;
+        }
+        *token |= static_cast<uint8_t>(matchCode < 15 ? matchCode : 15);
+        put16(op, static_cast<uint16_t>(offset));
+        op += 2;
+        if (matchCode >= 15) op = putLength(op, matchCode);
+        return op;
+    }
+}
+
+TrajectoryWriter::~TrajectoryWriter() {
+    close();
+}
+
+bool TrajectoryWriter::open(const std::string &path, int breite, int hohe, const Options &opts) {
+    close();
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Aufzeichnung: " << path << " kann nicht geschrieben werden\n";
+        return false;
+    }
+    options = opts;
+    cellCount = breite * hohe;
+
+    uint8_t header[13] = {'S', 'N', 'K', 'T'};
+    put16(header + 4, FORMAT_VERSION);
+    put16(header + 6, static_cast<uint16_t>(breite));
+    put16(header + 8, static_cast<uint16_t>(hohe));
+    put16(header + 10, static_cast<uint16_t>(options.keyframeInterval));
+    header[12] = options.compress ? METHOD_LZ : METHOD_RAW;
+    std::fwrite(header, 1, sizeof(header), file);
+
+    // Platz fuer einen vollen Block plus den groessten moeglichen Record (Delta mit allen Zellen),
+    // danach allokiert record() nicht mehr
+    const size_t capacity = options.blockSize + 16 + static_cast<size_t>(cellCount) * 6;
+    front.clear();
+    back.clear();
+    front.reserve(capacity);
+    back.reserve(capacity);
+    compressed.resize(maxCompressedSize(capacity) + 9);
+    previous.assign(cellCount, EMPTY);
+    keyframeDue = true;
+    sinceKeyframe = 0;
+    ticks = 0;
+    totalRaw = 0;
+    totalWritten = sizeof(header);
+    stalls = 0;
+    backFull = false;
+    stopping = false;
+
+    writer = std::thread(&TrajectoryWriter::writerLoop, this);
+    return true;
+}
+
+void TrajectoryWriter::close() {
+    if (!file) {
+        return;
+    }
+    if (!front.empty()) {
+        handOff();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cv.notify_all();
+    writer.join();
+    std::fclose(file);
+    file = nullptr;
+}
+
+void TrajectoryWriter::record(uint8_t action, int8_t reward, bool done, const uint8_t *board) {
+    if (!file) {
+        return;
+    }
+    const bool keyframe = keyframeDue || sinceKeyframe >= options.keyframeInterval;
+    front.push_back(static_cast<uint8_t>((keyframe ? 1 : 0) | (done ? 2 : 0) | ((action & 7) << 2)));
+    front.push_back(static_cast<uint8_t>(reward));
+
+    if (keyframe) {
+        putVarint(front, ticks);
+        front.insert(front.end(), board, board + cellCount);
+        std::memcpy(previous.data(), board, cellCount);
+        keyframeDue = false;
+        sinceKeyframe = 0;
+    } else {
+        // Erst zaehlen, dann schreiben: so steht die Anzahl vorne und es braucht keinen Zwischenpuffer.
+        // Pro Tick aendern sich nur eine Handvoll Zellen, gleiche 8-Byte-Woerter werden uebersprungen
+        size_t changed = 0;
+        int firstChanged = cellCount;
+        for (int i = 0; i < cellCount; i += 8) {
+            if (i + 8 <= cellCount && read64(board + i) == read64(previous.data() + i)) {
+                continue;
+            }
+            for (int j = i; j < cellCount && j < i + 8; j++) {
+                if (board[j] != previous[j]) {
+                    changed++;
+                    firstChanged = std::min(firstChanged, j);
+                }
+            }
+        }
+        putVarint(front, changed);
+        int last = 0;
+        for (int i = firstChanged; i < cellCount && changed > 0; i++) {
+            if (board[i] != previous[i]) {
+                putVarint(front, static_cast<uint64_t>(i - last));
+                front.push_back(board[i]);
+                previous[i] = board[i];
+                last = i;
+                changed--;
+            }
+        }
+    }
+    sinceKeyframe++;
+    ticks++;
+    // Nach dem Ende einer Episode beginnt die naechste mit einem Keyframe
+    if (done) {
+        keyframeDue = true;
+    }
+    if (front.size() >= options.blockSize) {
+        handOff();
+    }
+}
+
+void TrajectoryWriter::handOff() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (backFull) {
+        // Schreib-Thread hat den letzten Block noch nicht fertig: nur hier wartet die Simulation
+        stalls++;
+        cv.wait(lock, [this] { return !backFull; });
+    }
+    totalRaw += front.size();
+    std::swap(front, back);
+    backFull = true;
+    lock.unlock();
+    cv.notify_all();
+    front.clear();
+}
+
+void TrajectoryWriter::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        cv.wait(lock, [this] { return backFull || stopping; });
+        if (backFull) {
+            lock.unlock();
+            writeBlock(back);
+            back.clear();
+            lock.lock();
+            backFull = false;
+            cv.notify_all();
+            continue;
+        }
+        break;
+    }
+    std::fflush(file);
+}
+
+void TrajectoryWriter::writeBlock(const std::vector<uint8_t> &block) {
+    uint8_t *payload = compressed.data() + 9;
+    size_t stored = block.size();
+    uint8_t method = METHOD_RAW;
+    if (options.compress) {
+        const size_t size = compressBlock(block.data(), block.size(), payload);
+        if (size < block.size()) {
+            stored = size;
+            method = METHOD_LZ;
+        }
+    }
+    if (method == METHOD_RAW) {
+        std::memcpy(payload, block.data(), block.size());
+    }
+    put32(compressed.data(), static_cast<uint32_t>(block.size()));
+    put32(compressed.data() + 4, static_cast<uint32_t>(stored));
+    compressed[8] = method;
+    std::fwrite(compressed.data(), 1, stored + 9, file);
+    totalWritten.fetch_add(stored + 9, std::memory_order_relaxed);
+}
+
+size_t TrajectoryWriter::compressBlock(const uint8_t *in, size_t size, uint8_t *out) {
+    // Letzte Position pro Hash der naechsten 4 Bytes (+1, 0 = leer)
+    uint32_t table[1 << HASH_BITS] = {};
+    uint8_t *op = out;
+    size_t anchor = 0;
+    size_t ip = 0;
+
+    while (ip + MIN_MATCH <= size) {
+        const uint32_t sequence = read32(in + ip);
+        const uint32_t hash = (sequence * 2654435761u) >> (32 - HASH_BITS);
+        const size_t candidate = table[hash];
+        table[hash] = static_cast<uint32_t>(ip + 1);
+
+        if (candidate == 0 || ip - (candidate - 1) > MAX_OFFSET || read32(in + candidate - 1) != sequence) {
+            ip++;
+            continue;
+        }
+        const size_t match = candidate - 1;
+        size_t length = MIN_MATCH;
+        while (ip + length < size && in[match + length] == in[ip + length]) {
+            length++;
+        }
+        op = putSequence(op, in + anchor, ip - anchor, ip - match, length);
+        ip += length;
+        anchor = ip;
+    }
+    // Rest als Literale, ohne Match (markiert das Ende)
+    op = putSequence(op, in + anchor, size - anchor, 0, 0);
+    return static_cast<size_t>(op - out);
+}
+
+bool TrajectoryWriter::decompressBlock(const uint8_t *in, size_t size, uint8_t *out, size_t outSize) {
+    const uint8_t *ip = in;
+    const uint8_t *end = in + size;
+    size_t op = 0;
+
+    while (ip < end) {
+        const uint8_t token = *ip++;
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(ip, end, literalLength)) return false;
+        if (literalLength > static_cast<size_t>(end - ip) || literalLength > outSize - op) return false;
+        std::memcpy(out + op, ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+        if (ip == end) break;
+
+        if (end - ip < 2) return false;
+        const size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(ip, end, matchLength)) return false;
+        matchLength += MIN_MATCH;
+        if (offset == 0 || offset > op || matchLength > outSize - op) return false;
+        // Byteweise, weil sich Quelle und Ziel ueberlappen duerfen
+        for (size_t i = 0; i < matchLength; i++, op++) {
+            out[op] = out[op - offset];
+        }
+    }
+    return op == outSize;
+}
@@ -0,0 +1,101 @@
+#ifndef SNAKEGAME_TRAJECTORYWRITER_H
+#define SNAKEGAME_TRAJECTORYWRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Zeichnet AutoPlay-Partien als Trainingsdaten auf: pro Tick Aktion, Belohnung und Brett.
+// Das Brett wird als Delta (nur geaenderte Zellen) gespeichert, alle keyframeInterval Ticks
+// und zu Beginn jeder Episode komplett.
+//
+// Dateiformat (little endian):
+//   Kopf:   "SNKT" | u16 Version | u16 breite | u16 hohe | u16 keyframeInterval | u8 Kompression
+//   Bloecke: u32 Rohgroesse | u32 gespeicherte Groesse | u8 Methode (0 = roh, 1 = LZ) | Daten
+// Die Bloecke enthalten nur ganze Records:
+//   u8 Tag (Bit 0 Keyframe, Bit 1 Episode zu Ende, Bits 2-4 Aktion) | i8 Belohnung
+//   Keyframe: varint Tick | breite*hohe Zellen
+//   Delta:    varint Anzahl | pro Zelle varint Indexabstand zur vorigen + u8 Wert
+//
+// record() haengt nur Bytes an einen vorreservierten Puffer an. Ist ein Block voll, wird er mit
+// dem zweiten Puffer getauscht und ein Hintergrund-Thread komprimiert und schreibt ihn.
+class TrajectoryWriter {
+public:
+    // Zellwerte im aufgezeichneten Brett
+    enum Cell : uint8_t {
+        EMPTY = 0,
+        WALL = 1,
+        BODY = 2,
+        FOOD = 3,
+        HEAD = 4,
+    };
+
+    struct Options {
+        int keyframeInterval = 256;
+        bool compress = true;
+        size_t blockSize = 64 * 1024;
+    };
+
+    TrajectoryWriter() = default;
+    ~TrajectoryWriter();
+    TrajectoryWriter(const TrajectoryWriter&) = delete;
+    TrajectoryWriter& operator=(const TrajectoryWriter&) = delete;
+
+    bool open(const std::string &path, int breite, int hohe, const Options &options);
+    bool open(const std::string &path, int breite, int hohe) { return open(path, breite, hohe, Options{}); }
+    // Schreibt den Rest und beendet den Thread
+    void close();
+    [[nodiscard]] bool isOpen() const { return file != nullptr; }
+
+    // board: breite*hohe Zellwerte nach dem Tick
+    void record(uint8_t action, int8_t reward, bool done, const uint8_t *board);
+    // Naechster Record wird ein Keyframe (z.B. neue Episode)
+    void forceKeyframe() { keyframeDue = true; }
+
+    [[nodiscard]] uint64_t ticksRecorded() const { return ticks; }
+    [[nodiscard]] uint64_t rawBytes() const { return totalRaw; }
+    // Nur nach close() vollstaendig (der Thread schreibt asynchron)
+    [[nodiscard]] uint64_t writtenBytes() const { return totalWritten.load(std::memory_order_relaxed); }
+    // Wie oft record() auf den Schreib-Thread warten musste
+    [[nodiscard]] uint64_t stallCount() const { return stalls; }
+
+    // LZ77-Blockkompression im Stil von LZ4 (Token mit Literal-/Match-Laenge, 16-Bit-Offset)
+    [[nodiscard]] static size_t maxCompressedSize(size_t size) { return size + size / 255 + 16; }
+    static size_t compressBlock(const uint8_t *in, size_t size, uint8_t *out);
+    // false bei kaputten Daten oder falscher Groesse
+    static bool decompressBlock(const uint8_t *in, size_t size, uint8_t *out, size_t outSize);
+
+private:
+    FILE *file = nullptr;
+    Options options;
+    int cellCount = 0;
+
+    std::vector<uint8_t> front;         // wird von record() gefuellt
+    std::vector<uint8_t> back;          // gehoert waehrenddessen dem Schreib-Thread
+    std::vector<uint8_t> compressed;
+    std::vector<uint8_t> previous;      // Brett des letzten Records
+    bool keyframeDue = true;
+    int sinceKeyframe = 0;
+
+    std::thread writer;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool backFull = false;
+    bool stopping = false;
+
+    uint64_t ticks = 0;
+    uint64_t totalRaw = 0;
+    std::atomic<uint64_t> totalWritten{0};
+    uint64_t stalls = 0;
+
+    void handOff();
+    void writerLoop();
+    void writeBlock(const std::vector<uint8_t> &block);
+};
+
+#endif //SNAKEGAME_TRAJECTORYWRITER_H
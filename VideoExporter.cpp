@@ -0,0 +1,170 @@
+#include "VideoExporter.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    // BT.601 mit voller Farbskala (JPEG), 16 Bit Festkomma
+    uint8_t clampByte(int value) {
+        return static_cast<uint8_t>(std::clamp(value, 0, 255));
+    }
+
+    uint8_t lumaOf(int r, int g, int b) {
+        return clampByte((19595 * r + 38470 * g + 7471 * b + 32768) >> 16);
+    }
+
+    bool endsWith(const std::string &text, const char *suffix) {
+        const std::string end(suffix);
+        return text.size() >= end.size() && text.compare(text.size() - end.size(), end.size(), end) == 0;
+    }
+}
+
+VideoExporter::~VideoExporter() {
+    close();
+}
+
+bool VideoExporter::open(const std::string &path, int width, int height, int fps, int queueFrames) {
+    close();
+    if (width <= 0 || height <= 0) {
+        std::cerr << "Video: ungueltige Groesse " << width << "x" << height << "\n";
+        return false;
+    }
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Video: " << path << " kann nicht geschrieben werden\n";
+        return false;
+    }
+    fileFormat = endsWith(path, ".y4m") ? Format::Y4M : Format::PPM;
+    frameWidth = width;
+    frameHeight = height;
+    frameBytes = static_cast<size_t>(width) * height * 3;
+
+    // Alle Puffer jetzt, danach allokieren weder Simulation noch Schreib-Thread
+    slots.assign(static_cast<size_t>(std::max(2, queueFrames)), std::vector<uint8_t>(frameBytes));
+    const size_t chroma = static_cast<size_t>((width + 1) / 2) * ((height + 1) / 2);
+    encoded.assign(fileFormat == Format::Y4M ? static_cast<size_t>(width) * height + 2 * chroma : 0, 0);
+    head = tail = queued = 0;
+    acquired = false;
+    stopping = false;
+    submitted = 0;
+    stalls = 0;
+    totalWritten = 0;
+
+    if (fileFormat == Format::Y4M) {
+        const int written = std::fprintf(file, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", width, height,
+                                         std::max(1, fps));
+        totalWritten = static_cast<uint64_t>(std::max(0, written));
+    }
+    writer = std::thread(&VideoExporter::writerLoop, this);
+    return true;
+}
+
+void VideoExporter::close() {
+    if (!file) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cv.notify_all();
+    writer.join();
+    std::fclose(file);
+    file = nullptr;
+}
+
+uint8_t *VideoExporter::acquireFrame() {
+    if (!file) {
+        return nullptr;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    if (queued == slots.size()) {
+        // Schreib-Thread haengt um eine ganze Schlange hinterher: nur hier wartet die Simulation
+        stalls++;
+        cv.wait(lock, [this] { return queued < slots.size(); });
+    }
+    acquired = true;
+    return slots[head].data();
+}
+
+void VideoExporter::submitFrame() {
+    if (!file || !acquired) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        head = (head + 1) % slots.size();
+        queued++;
+        acquired = false;
+    }
+    submitted++;
+    cv.notify_all();
+}
+
+void VideoExporter::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        cv.wait(lock, [this] { return queued > 0 || stopping; });
+        if (queued == 0) {
+            break;      // stopping und nichts mehr offen
+        }
+        // Der Platz am Ende gehoert bis zum Weiterschalten nur diesem Thread
+        const uint8_t *rgb = slots[tail].data();
+        lock.unlock();
+        writeFrame(rgb);
+        lock.lock();
+        tail = (tail + 1) % slots.size();
+        queued--;
+        cv.notify_all();
+    }
+}
+
+void VideoExporter::writeFrame(const uint8_t *rgb) {
+    uint64_t bytes = 0;
+    if (fileFormat == Format::Y4M) {
+        rgbToYuv420(rgb, frameWidth, frameHeight, encoded.data());
+        bytes += std::fwrite("FRAME\n", 1, 6, file);
+        bytes += std::fwrite(encoded.data(), 1, encoded.size(), file);
+    } else {
+        const int written = std::fprintf(file, "P6\n%d %d\n255\n", frameWidth, frameHeight);
+        bytes += static_cast<uint64_t>(std::max(0, written));
+        bytes += std::fwrite(rgb, 1, frameBytes, file);
+    }
+    totalWritten.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void VideoExporter::rgbToYuv420(const uint8_t *rgb, int width, int height, uint8_t *out) {
+    const size_t stride = static_cast<size_t>(width) * 3;
+    for (int y = 0; y < height; y++) {
+        const uint8_t *p = rgb + y * stride;
+        uint8_t *luma = out + static_cast<size_t>(y) * width;
+        for (int x = 0; x < width; x++, p += 3) {
+            luma[x] = lumaOf(p[0], p[1], p[2]);
+        }
+    }
+
+    const int chromaWidth = (width + 1) / 2;
+    const int chromaHeight = (height + 1) / 2;
+    uint8_t *cb = out + static_cast<size_t>(width) * height;
+    uint8_t *cr = cb + static_cast<size_t>(chromaWidth) * chromaHeight;
+    for (int cy = 0; cy < chromaHeight; cy++) {
+        for (int cx = 0; cx < chromaWidth; cx++) {
+            // Mittel ueber den 2x2-Block, am rechten/unteren Rand ggf. weniger Pixel
+            int r = 0, g = 0, b = 0, n = 0;
+            for (int y = 2 * cy; y < std::min(height, 2 * cy + 2); y++) {
+                for (int x = 2 * cx; x < std::min(width, 2 * cx + 2); x++) {
+                    const uint8_t *p = rgb + y * stride + static_cast<size_t>(x) * 3;
+                    r += p[0];
+                    g += p[1];
+                    b += p[2];
+                    n++;
+                }
+            }
+            r /= n;
+            g /= n;
+            b /= n;
+            const size_t i = static_cast<size_t>(cy) * chromaWidth + cx;
+            cb[i] = clampByte((-11059 * r - 21709 * g + 32768 * b + (128 << 16) + 32768) >> 16);
+            cr[i] = clampByte((32768 * r - 27439 * g - 5329 * b + (128 << 16) + 32768) >> 16);
+        }
+    }
+}
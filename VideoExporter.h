@@ -0,0 +1,77 @@
+#ifndef SNAKEGAME_VIDEOEXPORTER_H
+#define SNAKEGAME_VIDEOEXPORTER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Schreibt RGB-Frames als unkomprimierten Video-Stream, ohne Bilder zu verwerfen:
+//   .y4m      YUV4MPEG2, 4:2:0 (C420jpeg, volle Farbskala nach BT.601), z.B. fuer ffmpeg/mpv
+//   sonst     aneinandergehaengte PPM-Bilder (P6), z.B. "ffmpeg -f image2pipe -c:v ppm -i datei.ppm"
+//
+// Die Frames liegen in einer festen Ringschlange (queueFrames Plaetze, beim open() angelegt).
+// Die Simulation holt sich mit acquireFrame() einen freien Platz, rendert hinein und gibt ihn
+// mit submitFrame() ab; Farbumrechnung und Schreiben macht ein Hintergrund-Thread. Ist die
+// Schlange voll, wartet acquireFrame(), bis der Thread einen Platz frei hat (wird gezaehlt).
+class VideoExporter {
+public:
+    enum class Format { Y4M, PPM };
+
+    VideoExporter() = default;
+    ~VideoExporter();
+    VideoExporter(const VideoExporter&) = delete;
+    VideoExporter& operator=(const VideoExporter&) = delete;
+
+    bool open(const std::string &path, int width, int height, int fps = 30, int queueFrames = 8);
+    // Schreibt alle wartenden Frames und beendet den Thread
+    void close();
+    [[nodiscard]] bool isOpen() const { return file != nullptr; }
+    [[nodiscard]] Format format() const { return fileFormat; }
+
+    // width*height*3 Bytes RGB, gehoert dem Aufrufer bis submitFrame()
+    uint8_t *acquireFrame();
+    void submitFrame();
+
+    [[nodiscard]] uint64_t framesSubmitted() const { return submitted; }
+    // Nur nach close() vollstaendig (der Thread schreibt asynchron)
+    [[nodiscard]] uint64_t writtenBytes() const { return totalWritten.load(std::memory_order_relaxed); }
+    // Wie oft acquireFrame() auf den Schreib-Thread warten musste
+    [[nodiscard]] uint64_t stallCount() const { return stalls; }
+
+    // RGB (3 Bytes pro Pixel) nach planarem YUV 4:2:0, Chroma als Mittel ueber 2x2 Pixel.
+    // out braucht w*h + 2 * ((w+1)/2) * ((h+1)/2) Bytes
+    static void rgbToYuv420(const uint8_t *rgb, int width, int height, uint8_t *out);
+
+private:
+    FILE *file = nullptr;
+    Format fileFormat = Format::Y4M;
+    int frameWidth = 0;
+    int frameHeight = 0;
+    size_t frameBytes = 0;
+
+    std::vector<std::vector<uint8_t>> slots;    // Ringschlange der RGB-Frames
+    std::vector<uint8_t> encoded;               // YUV-Puffer des Schreib-Threads
+    size_t head = 0;                            // naechster Platz fuer acquireFrame()
+    size_t tail = 0;                            // naechster Platz fuer den Schreib-Thread
+    size_t queued = 0;                          // abgegebene, noch nicht geschriebene Frames
+    bool acquired = false;
+
+    std::thread writer;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stopping = false;
+
+    uint64_t submitted = 0;
+    std::atomic<uint64_t> totalWritten{0};
+    uint64_t stalls = 0;
+
+    void writerLoop();
+    void writeFrame(const uint8_t *rgb);
+};
+
+#endif //SNAKEGAME_VIDEOEXPORTER_H
@@ -0,0 +1,84 @@
+#include "VirtualSnake.h"
+#include <algorithm>
+
+VirtualSnake::VirtualSnake(int breite, int hohe)
+        : breite(breite),
+          hohe(hohe),
+          delta(static_cast<size_t>(breite) * hohe, 0) {
+    // Ein Pfad kann hoechstens jede Zelle einmal besuchen
+    heads.reserve(static_cast<size_t>(breite) * hohe);
+    steps.reserve(static_cast<size_t>(breite) * hohe);
+}
+
+void VirtualSnake::reset(const Snake &snake, const Grid &g) {
+    rollbackAll();
+    base = &snake;
+    grid = &g;
+    tailsPopped = 0;
+    pendingGrow = snake.isGrowing();
+}
+
+Point VirtualSnake::segmentFromTail(size_t popped) const {
+    const size_t baseLength = base->getLength();
+    if (popped < baseLength) {
+        return base->getBody()[baseLength - 1 - popped];
+    }
+    // Alle echten Segmente sind weg, der Schwanz liegt auf einem simulierten Kopf
+    return toPoint(heads[popped - baseLength]);
+}
+
+Point VirtualSnake::getHeadPosition() const {
+    return heads.empty() ? base->getHeadPosition() : toPoint(heads.back());
+}
+
+void VirtualSnake::apply(const Point &next) {
+    Step step{false, pendingGrow};
+
+    //REMOVE Schwanz zuerst (wie Snake::move), ausser es steht Wachstum aus
+    if (!pendingGrow) {
+        Point tail = segmentFromTail(tailsPopped);
+        --delta[toIndex(tail)];
+        ++tailsPopped;
+        step.poppedTail = true;
+    }
+    pendingGrow = false;
+
+    //ADD neuer Kopf
+    int index = toIndex(next);
+    ++delta[index];
+    heads.push_back(index);
+
+    // Essen gefressen: beim naechsten Zug bleibt der Schwanz liegen
+    if (grid->getCell(next) == CellType::FOOD) {
+        pendingGrow = true;
+    }
+    steps.push_back(step);
+}
+
+void VirtualSnake::rollback(size_t count) {
+    count = std::min(count, steps.size());
+    for (size_t i = 0; i < count; i++) {
+        const Step step = steps.back();
+        steps.pop_back();
+
+        --delta[heads.back()];
+        heads.pop_back();
+
+        if (step.poppedTail) {
+            --tailsPopped;
+            ++delta[toIndex(segmentFromTail(tailsPopped))];
+        }
+        pendingGrow = step.wasGrowing;
+    }
+}
+
+bool VirtualSnake::occupies(const Point &p) const {
+    if (!inBounds(p)) return false;
+    return base->countAt(p) + delta[toIndex(p)] > 0;
+}
+
+bool VirtualSnake::blocksCell(const Point &p) const {
+    if (!inBounds(p)) return false;
+    //SKIPPE den Schwanz, weil er sich beim naechsten Zug bewegt
+    return blocksIndex(toIndex(p));
+}
@@ -0,0 +1,65 @@
+#ifndef SNAKEGAME_VIRTUALSNAKE_H
+#define SNAKEGAME_VIRTUALSNAKE_H
+
+#include "Snake.h"
+#include <vector>
+#include <cstdint>
+
+// Simulierte Schlange fuer Pfad-Vorausschau: k Zuege werden als Delta ueber die echte
+// Snake gelegt, ohne Body oder Grid zu kopieren. Belegungsabfragen bleiben O(1),
+// rollback() nimmt die Zuege in O(k) wieder zurueck.
+// Bietet dieselben Abfragen wie Snake, damit die Pathfinder direkt darauf suchen koennen.
+class VirtualSnake {
+private:
+    struct Step {
+        bool poppedTail;        // Schwanz wurde bei diesem Zug entfernt
+        bool wasGrowing;        // Wachstum stand vor dem Zug noch aus
+    };
+
+    const Snake *base = nullptr;
+    const Grid *grid = nullptr;
+    int breite;
+    int hohe;
+
+    std::vector<int8_t> delta;  // Belegungs-Delta pro Zelle gegenueber der echten Snake
+    std::vector<int> heads;     // simulierte Koepfe (Zellindizes), aeltester zuerst
+    std::vector<Step> steps;
+    size_t tailsPopped = 0;     // wie viele Segmente am Schwanz bereits entfernt wurden
+    bool pendingGrow = false;
+
+    [[nodiscard]] int toIndex(const Point &p) const { return p.y * breite + p.x; }
+    [[nodiscard]] Point toPoint(int index) const { return {index % breite, index / breite}; }
+    [[nodiscard]] bool inBounds(const Point &p) const { return p.x >= 0 && p.x < breite && p.y >= 0 && p.y < hohe; }
+    // Segment, das nach tailsPopped entfernten Segmenten der Schwanz ist
+    [[nodiscard]] Point segmentFromTail(size_t popped) const;
+
+public:
+    VirtualSnake(int breite, int hohe);
+
+    // Auf die aktuelle Snake setzen (nur ohne offene Zuege erlaubt)
+    void reset(const Snake &snake, const Grid &grid);
+
+    // Einen Zug auf die Zelle next simulieren (Essen im Grid laesst die Schlange wachsen)
+    void apply(const Point &next);
+    // Die letzten count Zuege zuruecknehmen, O(count)
+    void rollback(size_t count);
+    void rollbackAll() { rollback(steps.size()); }
+    [[nodiscard]] size_t appliedMoves() const { return steps.size(); }
+
+    // Abfragen wie bei Snake
+    [[nodiscard]] Point getHeadPosition() const;
+    [[nodiscard]] Point getTailPosition() const { return segmentFromTail(tailsPopped); }
+    [[nodiscard]] size_t getLength() const { return base->getLength() + heads.size() - tailsPopped; }
+    [[nodiscard]] bool isGrowing() const { return pendingGrow; }
+    [[nodiscard]] bool occupies(const Point &p) const;
+    [[nodiscard]] bool blocksCell(const Point &p) const;
+
+    // Index-Varianten ohne Bounds-Check fuer die Suchkerne
+    [[nodiscard]] int getTailIndex() const { return toIndex(getTailPosition()); }
+    [[nodiscard]] bool blocksIndex(int index) const {
+        const int count = base->countAtIndex(index) + delta[index];
+        return count > 0 && !(count == 1 && getLength() > 1 && index == getTailIndex());
+    }
+};
+
+#endif //SNAKEGAME_VIRTUALSNAKE_H
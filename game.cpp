@@ -1,25 +1,39 @@
 #include "game.h"
+#include <cstdlib>
 
 // Game Implementation
 Game::Game(int breite, int hohe, int windowW, int windowH)
         : grid(breite, hohe, true),
-          snake(Point(breite / 2, hohe / 2), Direction::RIGHT),
-          score(0),
+          snake(Point(breite / 2, hohe / 2), breite, hohe, Direction::RIGHT),
           state(GameState::RUNNING),
-          rng(std::chrono::steady_clock::now().time_since_epoch().count()),
+          score(0),
+          currentAlgorithm(Pathfinder::Algorithm::BFS), // Standard
+          planner(breite, hohe),
+          speculative(breite, hohe),
           window(nullptr),
           renderer(nullptr),
           windowWidth(windowW),
           windowHeight(windowH),
-          lastMoveTime(0),
           moveDelay(150), // Move jede 150ms
+          rng(std::chrono::steady_clock::now().time_since_epoch().count()),
           obstacleGenerator(&grid),
-          currentAlgorithm(Pathfinder::Algorithm::BFS) // Standard
+          history(REWIND_HISTORY, snapshotBytes(breite, hohe))
 {
-    cellSize = std::min(windowWidth / breite, windowHeight / hohe);
+    cellSize = std::max(1, std::min(windowWidth / breite, windowHeight / hohe));
+
+    // Pfad-Puffer einmal auf die maximale Pfadlaenge reservieren, danach allokiert ein Tick nicht mehr
+    const size_t cells = static_cast<size_t>(breite) * hohe;
+    currentPath.reserve(cells);
+    currentPathPoints.reserve(cells);
+    foodIndex.reset(breite, hohe);
+    foodCandidates.reserve(FOOD_CANDIDATES);
+    observation.resize(cells);
+    snapshotIndices.resize(cells);
 
     pathfinder = Pathfinder::create(currentAlgorithm);
 
+    obstacleGenerator.setMemoryResource(&tickArena);
+    hamiltonCycle.setMemoryResource(&tickArena);
     generateObstaclesForLevel();
 
     // Essen spawnen
@@ -85,7 +99,7 @@ void Game::cleanup() {
 
 void Game::spawnFood() {
     //spawn nicht mehr als max Anzahl an Essen
-    if (foodPositions.size() >= maxFoodItems) {
+    if (foodIndex.size() >= maxFoodItems) {
         return;
     }
 
@@ -104,33 +118,27 @@ void Game::spawnFood() {
             found = true;
 
             //PRUEFEN, ob den cellen sind Schlange Korper ist
-            for (const Point &bodyPos: snake.getBody()) {
-                if (bodyPos == kandidat) {
-                    found = false;
-                    break;
-                }
+            if (snake.occupies(kandidat)) {
+                found = false;
             }
             //PRUEFEN, ob den cellen ist schon mit Essen besetzt (also nicht 2-mal in der gleichen cell spawnen)
-            for (const Point &foodPos: foodPositions) {
-                if (foodPos == kandidat) {
-                    found = false;
-                    break;
-                }
+            if (foodIndex.contains(kandidat)) {
+                found = false;
             }
         }
     }
     //FUEGEN neue Essen Position EIN
-    foodPositions.push_back(kandidat);
+    foodIndex.insert(kandidat);
+    hamiltonCycle.addFood(kandidat);
     grid.setCell(kandidat, CellType::FOOD);
+    pathfinder->onFoodChanged(foodIndex.positions());
 }
 
 void Game::removeFood(const Point& foodPos) {
-    for (auto it = foodPositions.begin(); it != foodPositions.end(); ++it) {
-        if (*it == foodPos) {
-            grid.setCell(foodPos,CellType::EMPTY);
-            foodPositions.erase(it);
-            break;
-        }
+    if (foodIndex.remove(foodPos)) {
+        hamiltonCycle.removeFood(foodPos);
+        grid.setCell(foodPos,CellType::EMPTY);
+        pathfinder->onFoodChanged(foodIndex.positions());
     }
 }
 
@@ -142,65 +150,193 @@ void Game::processInput(Direction dir) {
 void Game::generateObstaclesForLevel() {
     Point start = Point(grid.getBreite() / 2, grid.getHohe() / 2);
     obstacleGenerator.generateForLevel(level, start);
+    // Beim Levelwechsel liegt die Schlange schon im Feld: Kreuz/Ecken setzen Waende ohne Pruefung,
+    // der Body darf aber nie in einer Wand stecken (restoreSnapshot verlangt das auch)
+    for (const Point &segment : snake.getBody()) {
+        if (grid.getCell(segment) == CellType::WALL) {
+            grid.setCell(segment, CellType::EMPTY);
+        }
+    }
+    hamiltonDirty = true;
+    pathfinder->onLevelChanged();
+    slicedSearch.cancel();
+    wallsVersion++;
+}
+namespace {
+    // Tempostufen fuer +/- (Game::UNLIMITED_SPEED am Ende)
+    constexpr int SPEED_STEPS[] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, Game::UNLIMITED_SPEED};
+    constexpr int SPEED_STEP_COUNT = sizeof(SPEED_STEPS) / sizeof(SPEED_STEPS[0]);
+
+    // Pro update() hoechstens so lange simulieren, damit Eingaben und Frames nicht verhungern
+    constexpr auto MAX_BATCH_TIME = std::chrono::milliseconds(50);
+    // Mindestabstand zwischen zwei Frames, solange das Spiel laeuft
+    constexpr auto MIN_FRAME_TIME = std::chrono::milliseconds(16);
+
+    // F5 speichert hierhin, F9 laedt von hier
+    constexpr const char *SNAPSHOT_FILE = "snake.snap";
+    constexpr uint16_t SNAPSHOT_VERSION = 2;
+}
+
+std::chrono::microseconds Game::tickInterval() const {
+    const int multiplier = std::max(1, speedMultiplier);
+    return std::chrono::microseconds(std::max<long long>(1, moveDelay * 1000LL / multiplier));
+}
+
+void Game::setSpeed(int multiplier) {
+    speedMultiplier = multiplier == UNLIMITED_SPEED ? UNLIMITED_SPEED : std::clamp(multiplier, 1, MAX_SPEED);
+    nextTickAt = std::chrono::steady_clock::now() + (speedMultiplier == UNLIMITED_SPEED ? std::chrono::microseconds(0) : tickInterval());
+    needsRender = true;
+    if (speedMultiplier == UNLIMITED_SPEED) {
+        std::cout << "Tempo: unbegrenzt (Frame alle " << renderEveryTicks << " Ticks)\n";
+    } else {
+        std::cout << "Tempo: " << speedMultiplier << "x\n";
+    }
+}
+
+void Game::changeSpeed(int steps) {
+    // Aktuelle Stufe suchen (Zwischenwerte aus --speed= zaehlen zur naechsthoeheren)
+    int index = SPEED_STEP_COUNT - 1;
+    if (speedMultiplier != UNLIMITED_SPEED) {
+        for (int i = 0; i < SPEED_STEP_COUNT - 1; i++) {
+            if (SPEED_STEPS[i] >= speedMultiplier) {
+                index = i;
+                break;
+            }
+        }
+    }
+    index = std::clamp(index + steps, 0, SPEED_STEP_COUNT - 1);
+    setSpeed(SPEED_STEPS[index]);
 }
+
 void Game::update() {
     if (state != GameState::RUNNING) {
         return;
     }
+    using Clock = std::chrono::steady_clock;
+    const auto now = Clock::now();
+    const auto batchEnd = now + MAX_BATCH_TIME;
+
+    if (speedMultiplier == UNLIMITED_SPEED) {
+        // So viele Ticks wie moeglich, danach einen Frame (alle renderEveryTicks Ticks)
+        for (int i = 0; i < renderEveryTicks && state == GameState::RUNNING; i++) {
+            runTimedTick();
+            if ((i & 63) == 63 && Clock::now() >= batchEnd) break;
+        }
+        return;
+    }
 
-    Uint32 currentTime = SDL_GetTicks();
-    if (currentTime - lastMoveTime < moveDelay) {
+    if (now < nextTickAt) {
         return; //Noch ist es nicht Zeit, zubewegen
     }
-    lastMoveTime = currentTime;
+    // Faellige Ticks nachholen (bei hohem Tempo mehrere pro Frame)
+    const auto interval = tickInterval();
+    while (now >= nextTickAt && state == GameState::RUNNING) {
+        runTimedTick();
+        nextTickAt += interval;
+        if (Clock::now() >= batchEnd) break;
+    }
+    // Zu weit im Rueckstand (Rechner zu langsam fuer das Tempo): nicht endlos nachholen
+    if (now >= nextTickAt) {
+        nextTickAt = now + interval;
+    }
+}
+
+void Game::runTimedTick() {
+    // Zustand vor dem Tick fuer das Zurueckspulen merken (gehoert nicht zur Tick-Zeit)
+    saveSnapshot(history.push());
+
+    const auto tickStart = std::chrono::steady_clock::now();
+    tick();
+    const auto tickEnd = std::chrono::steady_clock::now();
+    lastTickMicros = std::chrono::duration<double, std::micro>(tickEnd - tickStart).count();
+    needsRender = true;
+
+    // Erreichte Ticks pro Sekunde
+    tickRateWindowTicks++;
+    const double windowSeconds = std::chrono::duration<double>(tickEnd - tickRateWindowStart).count();
+    if (windowSeconds >= 0.5) {
+        ticksPerSecond = tickRateWindowTicks / windowSeconds;
+        tickRateWindowTicks = 0;
+        tickRateWindowStart = tickEnd;
+    }
+
+    // Der Zug fuer die letzte Eingabe ist passiert
+    if (inputPending) {
+        inputPending = false;
+        lastInputLatencyMs = static_cast<double>(SDL_GetTicks() - inputTimestamp);
+        inputLatencySumMs += lastInputLatencyMs;
+        inputLatencySamples++;
+    }
+}
+
+void Game::tick() {
+    if (state != GameState::RUNNING) {
+        return;
+    }
+    // Alles Temporaere aus dem letzten Tick freigeben (die Bloecke bleiben)
+    tickArena.reset();
+    tickCount++;
 
     // AI-Bewegung berechnen, wenn AutoPlay aktiviert ist
     if (autoPlay) {
-        updatePathfinding();
-        Direction nextMove = getNextAIMove();
+        // Richtung des letzten Zugs merken: getNextAIMove() setzt die Schlange schon auf den Plan
+        const Direction travel = snake.getDirection();
+        Direction nextMove = hamiltonMode ? getHamiltonMove() : Direction::NONE;
+        if (nextMove == Direction::NONE) {
+            updatePathfinding();
+            nextMove = getNextAIMove();
+            // Zug ablehnen, wenn er in eine Tasche fuehrt, die kleiner als die Schlange ist
+            nextMove = moveSafety.chooseSafest(grid, snake, nextMove, travel);
+        }
+        lastNodesExpanded = pathfinder->takeNodesExpanded() + slicedSearch.takeNodesExpanded()
+                            + speculative.takeNodesExpanded();
         if (nextMove != Direction::NONE) {
+            // Gegen die echte Laufrichtung pruefen, nicht gegen den Plan (sonst fiele z.B. RIGHT -> DOWN
+            // weg, wenn UP geplant war)
+            snake.setDirection(travel);
             snake.setDirection(nextMove);
         }
     }
 
+    const Direction action = snake.getDirection();
     snake.move();
 
     if (snake.checkWallCollision(grid)){
         state = GameState::GAME_OVER;
+        recordTick(action, -1, true);
+        captureFrame();
         return;
     }
 
     if (snake.checkSelfCollision()){
         state = GameState::GAME_OVER;
+        recordTick(action, -1, true);
+        captureFrame();
         return;
     }
 
     Point head = snake.getHeadPosition();
     bool foodeaten = false;
-    for (const Point &foodPos: foodPositions) {
-        if (head == foodPos) {
-            //vergrößere die Schlange
-            snake.grow();
+    if (foodIndex.contains(head)) {
+        //vergrößere die Schlange
+        snake.grow();
 
-            score++;
-            hud.updateScore(score, renderer, windowWidth);
+        score++;
+        hud.updateScore(score);
 
-            //entfernen das Essen
-            removeFood(foodPos);
+        //entfernen das Essen
+        removeFood(head);
 
-            //spawn neues Essen
-            spawnFood();
+        //spawn neues Essen
+        spawnFood();
 
-            foodeaten = true;
-            break;
-        }
+        foodeaten = true;
     }
     // Neuen Pfad berechnen nach Food-Aufnahme
 
     if (foodeaten && autoPlay) {
         currentPath.clear();
         currentPathPoints.clear();
-        grid.clearPath(); // Grid-Pfad auch löschen
     }
     // Nach Essen: Level-Check
     // Beispiel: alle 5 Punkte neues Level
@@ -213,6 +349,237 @@ void Game::update() {
             generateObstaclesForLevel();
          }
     }
+    // Zug steht fest: den Pfad fuer den naechsten Tick schon jetzt im Hintergrund planen lassen
+    if (autoPlay && !hamiltonMode && searchBudget.unlimited() && speculative.isRunning()) {
+        speculative.submit(SpeculativePlanner::Key{tickCount + 1, stateStamp}, currentAlgorithm, wallsVersion,
+                           grid, snake, foodIndex);
+    }
+    recordTick(action, foodeaten ? 1 : 0, false);
+    captureFrame();
+}
+
+void Game::recordTick(Direction action, int8_t reward, bool done) {
+    if (!recorder.isOpen()) {
+        return;
+    }
+    // Brett aus Waenden, Essen und Schlange zusammensetzen (das Grid selbst haelt nur Waende/Essen)
+    const CellType *cells = grid.data();
+    const int breite = grid.getBreite();
+    for (size_t i = 0; i < observation.size(); i++) {
+        observation[i] = cells[i] == CellType::WALL ? TrajectoryWriter::WALL : TrajectoryWriter::EMPTY;
+    }
+    for (const Point &foodPos : foodIndex.positions()) {
+        observation[foodPos.y * breite + foodPos.x] = TrajectoryWriter::FOOD;
+    }
+    for (const Point &segment : snake.getBody()) {
+        observation[segment.y * breite + segment.x] = TrajectoryWriter::BODY;
+    }
+    const Point head = snake.getHeadPosition();
+    if (grid.isInBounds(head)) {
+        observation[head.y * breite + head.x] = TrajectoryWriter::HEAD;
+    }
+    recorder.record(static_cast<uint8_t>(action), reward, done, observation.data());
+}
+
+bool Game::startVideo(const std::string &path, int cellPixels, int fps) {
+    frameRenderer.resize(grid.getBreite(), grid.getHohe(), cellPixels > 0 ? cellPixels : cellSize);
+    if (!video.open(path, frameRenderer.width(), frameRenderer.height(), fps)) {
+        return false;
+    }
+    // Startbild vor dem ersten Tick
+    captureFrame();
+    return true;
+}
+
+void Game::captureFrame() {
+    if (!video.isOpen()) {
+        return;
+    }
+    static const std::vector<Point> noPath;
+    uint8_t *frame = video.acquireFrame();
+    frameRenderer.render(grid, snake, foodIndex.positions(), autoPlay ? displayedPath() : noPath, frame);
+    video.submitFrame();
+}
+
+size_t Game::snapshotBytes(int breite, int hohe) {
+    // Kopf + Grid (2 Bit pro Zelle) + beide Zufallsgeneratoren + etwas Platz fuer Body/Essen,
+    // laengere Schlangen vergroessern den Slot einmalig
+    const size_t cells = static_cast<size_t>(breite) * hohe;
+    return 64 + (cells + 3) / 4 + 2 * sizeof(EngineState::Words) + 256 * sizeof(uint32_t);
+}
+
+void Game::saveSnapshot(GameSnapshot &snapshot) const {
+    const int breite = grid.getBreite();
+    snapshot.clear();
+    snapshot.tick = tickCount;
+    snapshot.put(SNAPSHOT_VERSION);
+    snapshot.put(static_cast<uint16_t>(breite));
+    snapshot.put(static_cast<uint16_t>(grid.getHohe()));
+
+    snapshot.put(tickCount);
+    snapshot.put(static_cast<int32_t>(score));
+    snapshot.put(static_cast<int32_t>(level));
+    snapshot.put(static_cast<uint8_t>(state));
+    snapshot.put(static_cast<uint8_t>(currentAlgorithm));
+    snapshot.put(static_cast<uint8_t>((autoPlay ? 1 : 0) | (hamiltonMode ? 2 : 0) | (hamiltonEngaged ? 4 : 0)));
+
+    // Schlange: Richtung, Wachstum, Body als Zellindizes (Kopf zuerst)
+    snapshot.put(static_cast<uint8_t>(snake.getDirection()));
+    snapshot.put(static_cast<uint8_t>(snake.isGrowing()));
+    snapshot.put(static_cast<uint32_t>(snake.getLength()));
+    for (const Point &segment : snake.getBody()) {
+        snapshot.put(static_cast<uint32_t>(segment.y * breite + segment.x));
+    }
+
+    snapshot.put(static_cast<uint32_t>(foodIndex.size()));
+    for (const Point &foodPos : foodIndex.positions()) {
+        snapshot.put(static_cast<uint32_t>(foodPos.y * breite + foodPos.x));
+    }
+
+    // Grid mit 2 Bit pro Zelle (CellType hat 4 Werte)
+    const CellType *cells = grid.data();
+    const size_t cellCount = static_cast<size_t>(breite) * grid.getHohe();
+    for (size_t i = 0; i < cellCount; i += 4) {
+        uint8_t packed = 0;
+        for (size_t j = 0; j < 4 && i + j < cellCount; j++) {
+            packed |= static_cast<uint8_t>(static_cast<uint8_t>(cells[i + j]) << (2 * j));
+        }
+        snapshot.put(packed);
+    }
+
+    // Zufallsgeneratoren als Zustandsworte: nach dem Restore kommen dieselben Essen und Level
+    snapshot.put(rngState.capture(rng));
+    snapshot.put(obstacleRngState.capture(obstacleGenerator.getRng()));
+}
+
+bool Game::restoreSnapshot(const GameSnapshot &snapshot) {
+    const int breite = grid.getBreite();
+    const size_t cellCount = static_cast<size_t>(breite) * grid.getHohe();
+    GameSnapshot::Reader in(snapshot);
+
+    uint16_t version = 0, snapBreite = 0, snapHohe = 0;
+    if (!in.get(version) || !in.get(snapBreite) || !in.get(snapHohe)) return false;
+    if (version != SNAPSHOT_VERSION || snapBreite != breite || snapHohe != grid.getHohe()) {
+        std::cerr << "Snapshot passt nicht zu diesem Spiel (Version " << version << ", "
+                  << snapBreite << "x" << snapHohe << ")\n";
+        return false;
+    }
+
+    uint64_t savedTick = 0;
+    int32_t savedScore = 0, savedLevel = 0;
+    uint8_t savedState = 0, savedAlgorithm = 0, flags = 0, direction = 0, growing = 0;
+    uint32_t length = 0;
+    bool ok = in.get(savedTick) && in.get(savedScore) && in.get(savedLevel) && in.get(savedState)
+              && in.get(savedAlgorithm) && in.get(flags) && in.get(direction) && in.get(growing)
+              && in.get(length) && length >= 1 && length <= cellCount
+              && in.getBytes(snapshotIndices.data(), length * sizeof(uint32_t));
+    if (!ok) return false;
+    // Erst alles lesen und pruefen, dann den Zustand anfassen. Enums kommen sonst ungeprueft in
+    // currentAlgorithm (Index in Pathfinder-Tabellen) oder Snake
+    if (savedState > static_cast<uint8_t>(GameState::GAME_OVER)
+        || savedAlgorithm > static_cast<uint8_t>(Pathfinder::Algorithm::PARALLEL_BFS)
+        || direction > static_cast<uint8_t>(Direction::NONE)) {
+        return false;
+    }
+    const uint32_t bodyLength = length;
+
+    uint32_t foodCount = 0;
+    if (!in.get(foodCount) || foodCount > cellCount - bodyLength) return false;
+    // Essen hinter dem Body im selben Puffer
+    if (!in.getBytes(snapshotIndices.data() + bodyLength, foodCount * sizeof(uint32_t))) return false;
+
+    // Grid mit 2 Bit pro Zelle, wird an Ort und Stelle geprueft und erst unten uebernommen
+    const uint8_t *packed = in.skip((cellCount + 3) / 4);
+    if (!packed) return false;
+    const auto cellAt = [packed](uint32_t index) {
+        return static_cast<CellType>((packed[index / 4] >> (2 * (index % 4))) & 3);
+    };
+    // Body: im Grid, aufeinanderfolgende Glieder sind Nachbarn, keine Wand (nur der Kopf nach dem
+    // toedlichen Zug bei GAME_OVER)
+    const bool headMayHitWall = savedState == static_cast<uint8_t>(GameState::GAME_OVER);
+    for (uint32_t i = 0; i < bodyLength; i++) {
+        const uint32_t index = snapshotIndices[i];
+        if (index >= cellCount) return false;
+        if (cellAt(index) == CellType::WALL && !(i == 0 && headMayHitWall)) return false;
+        if (i > 0) {
+            const uint32_t previous = snapshotIndices[i - 1];
+            const int dx = std::abs(static_cast<int>(index % breite) - static_cast<int>(previous % breite));
+            const int dy = std::abs(static_cast<int>(index / breite) - static_cast<int>(previous / breite));
+            if (dx + dy != 1) return false;
+        }
+    }
+    for (uint32_t i = 0; i < foodCount; i++) {
+        if (snapshotIndices[bodyLength + i] >= cellCount) return false;
+    }
+
+    EngineState::Words savedRng, savedObstacleRng;
+    if (!in.get(savedRng) || !in.get(savedObstacleRng) || !in.atEnd()) return false;
+    std::mt19937 restoredRng, restoredObstacleRng;
+    if (!EngineState::apply(savedRng, restoredRng) || !EngineState::apply(savedObstacleRng, restoredObstacleRng)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < cellCount; i++) {
+        grid.setCell(static_cast<int>(i % breite), static_cast<int>(i / breite), cellAt(i));
+    }
+
+    tickCount = savedTick;
+    score = savedScore;
+    level = savedLevel;
+    state = static_cast<GameState>(savedState);
+    autoPlay = flags & 1;
+    hamiltonMode = flags & 2;
+    snake.restore(snapshotIndices.data(), bodyLength, static_cast<Direction>(direction), growing != 0);
+
+    foodIndex.clear();
+    for (uint32_t i = 0; i < foodCount; i++) {
+        const uint32_t index = snapshotIndices[bodyLength + i];
+        foodIndex.insert(Point(static_cast<int>(index % breite), static_cast<int>(index / breite)));
+    }
+    rng = restoredRng;
+    obstacleGenerator.setRng(restoredObstacleRng);
+
+    // Abgeleitete Daten neu aufbauen: Pfadfinder-Caches, Hamilton-Kreis, Pfad
+    const auto algorithm = static_cast<Pathfinder::Algorithm>(savedAlgorithm);
+    if (algorithm != currentAlgorithm) {
+        currentAlgorithm = algorithm;
+        pathfinder = Pathfinder::create(currentAlgorithm);
+    }
+    pathfinder->onLevelChanged();
+    pathfinder->onFoodChanged(foodIndex.positions());
+    slicedSearch.cancel();
+    stateStamp++;
+    wallsVersion++;
+    hamiltonDirty = true;
+    hamiltonEngaged = false;
+    if (flags & 4) {
+        // Autopilot lief auf dem Kreis: gleich neu bauen, sonst wuerde er erst spaeter wieder einrasten
+        // und anders weiterlaufen als beim Speichern (nur dann kostet der Restore mehr als Mikrosekunden)
+        hamiltonDirty = false;
+        hamiltonCycle.build(grid, foodIndex.positions());
+        hamiltonEngaged = hamiltonCycle.isValid();
+    }
+    currentPath.clear();
+    currentPathPoints.clear();
+    hud.updateScore(score);
+    needsRender = true;
+    return true;
+}
+
+void Game::rewind(size_t ticks) {
+    if (history.empty()) {
+        std::cout << "Nichts zum Zurueckspulen\n";
+        return;
+    }
+    // Der neueste Snapshot ist der Zustand vor dem letzten Tick
+    const size_t steps = std::min(ticks, history.size());
+    if (!restoreSnapshot(*history.fromNewest(steps - 1))) {
+        return;
+    }
+    history.dropNewest(steps);
+    state = GameState::PAUSED;
+    std::cout << "Zurueckgespult auf Tick " << tickCount << " (" << history.size()
+              << " weitere verfuegbar, P zum Fortsetzen)\n";
 }
 
 void Game::render() {
@@ -224,7 +591,7 @@ void Game::render() {
     grid.clear();
 
     // platziere alle food items
-    for (const auto& foodPos : foodPositions) {
+    for (const auto& foodPos : foodIndex.positions()) {
         grid.setCell(foodPos, CellType::FOOD);
     }
 
@@ -236,79 +603,146 @@ void Game::render() {
 
     // Pfad rendern (falls vorhanden und AutoPlay aktiviert)
     if (autoPlay) {
-        grid.renderPathOverlay(renderer,cellSize);
+        grid.renderPathOverlay(renderer, cellSize, displayedPath());
     }
 
     // Präsentieren den rendered frame
+    hud.setStats(HUDStats{lastTickMicros, displayedPath().size(), lastNodesExpanded, lastInputLatencyMs,
+                          ticksPerSecond, speedMultiplier});
     hud.render(renderer, windowWidth, windowHeight);
     SDL_RenderPresent(renderer);
 }
 
 void Game::updatePathfinding() {
     // Wenn kein Food vorhanden, leere Pfad-Daten und return
-    if (foodPositions.empty()) {
+    if (foodIndex.empty()) {
         currentPath.clear();
         currentPathPoints.clear();
-        grid.clearPath();
-        return;
+            return;
     }
 
     Point start = snake.getHeadPosition();
-    Point goal = findClosestFood(start);
-
-    // DEBUG: Ausgabe der Positionen (0 UP,1 DOWN, 2 LEFT, 3 RIGHT, 4 NONE)
-    std::cout << "DEBUG: Snake Head: (" << start.x << "," << start.y << ")" << std::endl;
-    std::cout << "DEBUG: Target Food: (" << goal.x << "," << goal.y << ")" << std::endl;
-    std::cout << "DEBUG: Snake Direction: " << (int)snake.getDirection() << std::endl;
-
-    if (goal.x == -1 && goal.y == -1) {
-        currentPath.clear();
-        currentPathPoints.clear();
-        grid.clearPath();
+    if (!searchBudget.unlimited()) {
+        updateSlicedPathfinding(start);
         return;
     }
-
-    // Berechne neuen Pfad
-    std::vector<Point> pathPoints = pathfinder->findPath(start, goal, grid, snake);
-
-    // DEBUG: Pfad-Informationen
-    std::cout << "DEBUG: Path points found: " << pathPoints.size() << std::endl;
-    if (!pathPoints.empty()) {
-        std::cout << "DEBUG: First path point: (" << pathPoints[0].x << "," << pathPoints[0].y << ")" << std::endl;
+    // Hat der Hintergrund-Planer schon fuer genau diesen Zustand gerechnet, nur abholen
+    if (!speculative.take(SpeculativePlanner::Key{tickCount, stateStamp}, currentPathPoints)) {
+        planner.plan(*pathfinder, grid, snake, foodIndex, currentPathPoints);
     }
 
-    if (!pathPoints.empty()) {
-        currentPath = pathfinder->pathToDirections(pathPoints, start);
-        currentPathPoints = pathPoints;
-        grid.setPath(currentPathPoints);
+    if (!currentPathPoints.empty()) {
+        pathfinder->pathToDirections(currentPathPoints, start, currentPath);
 
-        // DEBUG: Richtungen ausgeben
-        std::cout << "DEBUG: Path directions: ";
-        for (Direction dir : currentPath) {
-            std::cout << (int)dir << " ";
+        // DEBUG: Richtungen ausgeben (die Schleife gibt es nur, wenn Debug-Logs einkompiliert sind)
+        if constexpr (Log::enabled(Log::Level::Debug)) {
+            char directions[128];
+            size_t used = 0;
+            for (size_t i = 0; i < currentPath.size() && used + 3 < sizeof(directions); i++) {
+                directions[used++] = static_cast<char>('0' + static_cast<int>(currentPath[i]));
+                directions[used++] = ' ';
+            }
+            directions[used] = '\0';
+            SNAKE_LOG_DEBUG("Path directions: %s%s", directions, used < 2 * currentPath.size() ? "..." : "");
         }
-        std::cout << std::endl;
     } else {
         // Kein Pfad gefunden
-        std::cout << "DEBUG: No path found!" << std::endl;
+        SNAKE_LOG_DEBUG("No path found!");
         currentPath.clear();
-        currentPathPoints.clear();
-        grid.clearPath();
+        }
+}
+
+void Game::updateSlicedPathfinding(Point start) {
+    // Neu ansetzen, wenn das Ziel gefressen ist oder die letzte Suche nichts gefunden hat
+    if (slicedSearch.status() == SlicedSearch::Status::IDLE || slicedSearch.status() == SlicedSearch::Status::NO_PATH
+        || !foodIndex.contains(slicedSearch.getGoal())) {
+        Point goal = findClosestFood(start);
+        if (slicedSearch.status() == SlicedSearch::Status::NO_PATH && foodIndex.size() > 1) {
+            // Eingesperrtes Essen nicht jeden Tick wieder anlaufen: reihum das naechste Essen probieren
+            foodIndex.nearest(start, FOOD_CANDIDATES, foodCandidates);
+            const auto failed = std::find(foodCandidates.begin(), foodCandidates.end(), slicedSearch.getGoal());
+            if (failed != foodCandidates.end()) {
+                goal = failed + 1 != foodCandidates.end() ? *(failed + 1) : foodCandidates.front();
+            }
+        }
+        if (goal.x == -1 && goal.y == -1) {
+            slicedSearch.cancel();
+            currentPath.clear();
+            currentPathPoints.clear();
+                    return;
+        }
+        slicedSearch.start(grid, goal);
+    }
+
+    const SlicedSearch::Status status = slicedSearch.step(grid, snake, searchBudget);
+    currentPathPoints.clear();
+    if (status == SlicedSearch::Status::FOUND) {
+        // Der Weg bleibt in der Suche und wird dort pro Tick nur um einen Schritt weitergeschoben,
+        // hier reicht der naechste Schritt (angezeigt wird ueber displayedPath())
+        if (slicedSearch.followPath(grid, snake, start)) {
+            currentPath.assign(1, pathfinder->getDirection(start, slicedSearch.path().back()));
+            return;
+        }
+        // Weg inzwischen durch den Body oder Kopf neben dem Baum: im naechsten Tick neu suchen,
+        // wie bei NO_PATH mit dem naechsten Essen
+        SNAKE_LOG_DEBUG("Sliced path blocked, restarting search");
+        slicedSearch.abandon();
+    }
+
+    // Teilantwort: ein Schritt Richtung Suchbaum (solange die Suche laeuft), sonst Richtung Essen.
+    // Die Schwanz-Vorausschau entfaellt hier, sie waere wieder eine unbegrenzte Suche;
+    // MoveSafety prueft den Zug trotzdem
+    const Point target = status == SlicedSearch::Status::RUNNING ? slicedSearch.nearestCell()
+                                                                 : slicedSearch.getGoal();
+    int bestDistance = std::numeric_limits<int>::max();
+    for (const Point &offset : Directions::ALL_DIRECTIONS) {
+        const Point next = start + offset;
+        if (!grid.isInBounds(next) || grid.getCell(next) == CellType::WALL || snake.blocksCell(next)) {
+            continue;
+        }
+        const int distance = std::abs(next.x - target.x) + std::abs(next.y - target.y);
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            currentPathPoints.assign(1, next);
+        }
+    }
+
+    if (currentPathPoints.empty()) {
+        currentPath.clear();
+        return;
+    }
+    pathfinder->pathToDirections(currentPathPoints, start, currentPath);
+}
+
+const std::vector<Point> &Game::displayedPath() const {
+    // Ein per Zeitscheiben gefundener Weg liegt nur in der Suche (rueckwaerts, fuer die Anzeige egal)
+    if (!searchBudget.unlimited() && slicedSearch.status() == SlicedSearch::Status::FOUND && currentPathPoints.empty()) {
+        return slicedSearch.path();
     }
+    return currentPathPoints;
+}
+
+bool Game::leavesTailReachable(const std::vector<Point>& pathPoints) {
+    return planner.leavesTailReachable(*pathfinder, grid, snake, pathPoints);
 }
 
 void Game::setAlgorithm(Pathfinder::Algorithm algo) {
     if (currentAlgorithm == algo) return;
     currentAlgorithm = algo;
     pathfinder = Pathfinder::create(currentAlgorithm);
+    pathfinder->onFoodChanged(foodIndex.positions());
+    stateStamp++;
     // Vorhandenen Pfad verwerfen, damit neu berechnet wird
     currentPath.clear();
     currentPathPoints.clear();
-    grid.clearPath();
     std::cout << "Pfadfindungs-Algorithmus gewechselt zu ";
     switch (currentAlgorithm) {
         case Pathfinder::Algorithm::BFS:     std::cout << "BFS\n"; break;
         case Pathfinder::Algorithm::DIJKSTRA:std::cout << "Dijkstra\n"; break;
+        case Pathfinder::Algorithm::DISTANCE_FIELD:std::cout << "Distanzfeld\n"; break;
+        case Pathfinder::Algorithm::HIERARCHICAL:std::cout << "HPA*\n"; break;
+        case Pathfinder::Algorithm::DSTAR_LITE:std::cout << "D* Lite\n"; break;
+        case Pathfinder::Algorithm::PARALLEL_BFS:std::cout << "Parallele BFS\n"; break;
     }
 }
 
@@ -320,7 +754,7 @@ Direction Game::getNextAIMove() {
 
     snake.setDirection(planned);
 
-    if (snake.getDirection() != planned && snake.getBody().size() < 3) {
+    if (snake.getDirection() != planned && snake.getLength() < 3) {
         // 180°-Turn blockiert - finde Alternative
         Point head = snake.getHeadPosition();
         Direction alternatives[] = {
@@ -359,11 +793,48 @@ void Game::toggleAutoPlay() {
         currentPath.clear();
     }
 }
+void Game::toggleHamiltonMode() {
+    hamiltonMode = !hamiltonMode;
+    hamiltonEngaged = false;
+    if (hamiltonMode) {
+        std::cout << "Hamilton-Autopilot aktiviert\n";
+    } else {
+        std::cout << "Hamilton-Autopilot deaktiviert\n";
+    }
+}
+
+Direction Game::getHamiltonMove() {
+    // Kreis nur einmal pro Level berechnen
+    if (hamiltonDirty) {
+        hamiltonDirty = false;
+        hamiltonEngaged = false;
+        hamiltonCycle.build(grid, foodIndex.positions());
+    }
+    if (!hamiltonCycle.isValid()) {
+        return Direction::NONE;
+    }
+    // Abkuerzungen sind nur sicher, solange der Body in Kreisreihenfolge liegt.
+    // Bis dahin uebernimmt der normale Pathfinder (Pruefung O(Laenge), danach nur noch O(1) pro Tick)
+    if (!hamiltonEngaged) {
+        hamiltonEngaged = hamiltonCycle.isBodyOrdered(snake);
+        if (!hamiltonEngaged) {
+            return Direction::NONE;
+        }
+        currentPath.clear();
+        currentPathPoints.clear();
+        }
+    Direction next = hamiltonCycle.nextMove(snake);
+    if (next == Direction::NONE) {
+        hamiltonEngaged = false;
+    }
+    return next;
+}
+
 void Game::reset() {
     // Reset das Spiel Status
     state = GameState::RUNNING;
     score = 0;
-    hud.updateScore(score, renderer, windowWidth);
+    hud.updateScore(score);
 
     // Reset das Grid
     grid.clear();
@@ -372,18 +843,22 @@ void Game::reset() {
     grid.initializeWalls();
 
     // Reset die Schlange pos
-    snake = Snake(Point(grid.getBreite() / 2, grid.getHohe() / 2));
+    snake = Snake(Point(grid.getBreite() / 2, grid.getHohe() / 2), grid.getBreite(), grid.getHohe());
 
     // Clear Essen positions
-    foodPositions.clear();
+    foodIndex.clear();
+    pathfinder->onFoodChanged(foodIndex.positions());
 
     // HINZUFÜGEN: Pfad-Variablen zurücksetzen
-    currentAlgorithm = Pathfinder::Algorithm::BFS;
-    pathfinder = Pathfinder::create(currentAlgorithm);
+    if (currentAlgorithm != Pathfinder::Algorithm::BFS) {
+        currentAlgorithm = Pathfinder::Algorithm::BFS;
+        pathfinder = Pathfinder::create(currentAlgorithm);
+    }
 
     currentPath.clear();
     currentPathPoints.clear();
-    grid.clearPath();
+    slicedSearch.cancel();
+    stateStamp++;
 
 
     // Spawn neue Essen
@@ -392,87 +867,136 @@ void Game::reset() {
     }
     grid.clearObstacles();
     generateObstaclesForLevel();
+    // Neue Episode in der Aufzeichnung
+    recorder.forceKeyframe();
 }
 
 Point Game::findClosestFood(const Point& position) const {
-    // Wenn kein Food da ist, gib einen ungültigen Punkt zurück
-    if (foodPositions.empty()) {
-        return Point(-1, -1);
-    }
-
-    // Initialisiere die Suche: als "aktuell nächstes Food" das erste in der Liste
-    Point closest = foodPositions[0];
-    // Setze die minimale Distanz hoch, damit jeder echte Wert kleiner ist
-    int minDistance = std::numeric_limits<int>::max();
-
-    // Durchlaufe alle Essen-Positionen
-    for (const Point& food : foodPositions) {
-        // Berechne die Manhattan-Distanz
-        int distance = std::abs(position.x - food.x) + std::abs(position.y - food.y);
-
-        // Wenn diese Distanz kleiner ist als bisher die kleinste,
-        // merke sie dir als neue minDistance und speichere das Essen
-        if (distance < minDistance) {
-            minDistance = distance;
-            closest = food;
-        }
-    }
-
-    // Gib die Position des nächsten Foods zurück
-    return closest;
+    // Naechstes Essen nach Manhattan-Distanz ueber den Eimer-Index, (-1, -1) wenn keins da ist
+    return foodIndex.nearest(position);
 }
 
 bool Game::handleEvents() {
     SDL_Event e;
     while (SDL_PollEvent(&e)) {
-        if (e.type == SDL_QUIT) {
+        if (!handleEvent(e)) {
             return false;
         }
+    }
+    return true;
+}
+
+bool Game::handleEvent(const SDL_Event& e) {
+    if (e.type == SDL_QUIT) {
+        return false;
+    }
+    // Fenster wieder sichtbar o.ae.: einmal neu zeichnen
+    if (e.type == SDL_WINDOWEVENT) {
+        needsRender = true;
+    }
 
-        if (e.type == SDL_KEYDOWN) {
-            switch (e.key.keysym.sym) {
-                case SDLK_w:
-                case SDLK_UP:
-                    if (!autoPlay) processInput(Direction::UP);  // Nur wenn AutoPlay aus ist
-                    break;
-                case SDLK_s:
-                case SDLK_DOWN:
-                    if (!autoPlay) processInput(Direction::DOWN);
-                    break;
-                case SDLK_a:
-                case SDLK_LEFT:
-                    if (!autoPlay) processInput(Direction::LEFT);
-                    break;
-                case SDLK_d:
-                case SDLK_RIGHT:
-                    if (!autoPlay) processInput(Direction::RIGHT);
-                    break;
-                case SDLK_1:
-                    setAlgorithm(Pathfinder::Algorithm::BFS);
-                    break;
-                case SDLK_2:
-                    setAlgorithm(Pathfinder::Algorithm::DIJKSTRA);
-                    break;
-                case SDLK_SPACE:
-                    updatePathfinding();
-                    toggleAutoPlay();
-                    break;
-                case SDLK_p:
-                    if (state == GameState::RUNNING) {
-                        state = GameState::PAUSED;
-                    } else if (state == GameState::PAUSED) {
-                        state = GameState::RUNNING;
-                    }
-                    break;
-                case SDLK_r:
-                    if (state == GameState::GAME_OVER) {
-                        reset();
-                    }
-                    break;
-                case SDLK_q:
-                case SDLK_ESCAPE:
-                    return false;
+    if (e.type == SDL_KEYDOWN) {
+        needsRender = true;
+        // Manuelle Richtungswechsel fuer die Latenzmessung merken (Zeitstempel des Events)
+        auto steer = [&](Direction dir) {
+            if (autoPlay) return;   // Nur wenn AutoPlay aus ist
+            processInput(dir);
+            if (state == GameState::RUNNING && !inputPending) {
+                inputPending = true;
+                inputTimestamp = e.key.timestamp;
             }
+        };
+        switch (e.key.keysym.sym) {
+            case SDLK_w:
+            case SDLK_UP:
+                steer(Direction::UP);
+                break;
+            case SDLK_s:
+            case SDLK_DOWN:
+                steer(Direction::DOWN);
+                break;
+            case SDLK_a:
+            case SDLK_LEFT:
+                steer(Direction::LEFT);
+                break;
+            case SDLK_d:
+            case SDLK_RIGHT:
+                steer(Direction::RIGHT);
+                break;
+            case SDLK_1:
+                setAlgorithm(Pathfinder::Algorithm::BFS);
+                break;
+            case SDLK_2:
+                setAlgorithm(Pathfinder::Algorithm::DIJKSTRA);
+                break;
+            case SDLK_3:
+                setAlgorithm(Pathfinder::Algorithm::DISTANCE_FIELD);
+                break;
+            case SDLK_4:
+                setAlgorithm(Pathfinder::Algorithm::HIERARCHICAL);
+                break;
+            case SDLK_5:
+                setAlgorithm(Pathfinder::Algorithm::DSTAR_LITE);
+                break;
+            case SDLK_6:
+                setAlgorithm(Pathfinder::Algorithm::PARALLEL_BFS);
+                break;
+            case SDLK_h:
+                toggleHamiltonMode();
+                break;
+            case SDLK_PLUS:
+            case SDLK_EQUALS:
+            case SDLK_KP_PLUS:
+                changeSpeed(1);
+                break;
+            case SDLK_MINUS:
+            case SDLK_KP_MINUS:
+                changeSpeed(-1);
+                break;
+            case SDLK_0:
+                setSpeed(1);
+                break;
+            case SDLK_SPACE:
+                updatePathfinding();
+                toggleAutoPlay();
+                break;
+            case SDLK_p:
+                if (state == GameState::RUNNING) {
+                    state = GameState::PAUSED;
+                } else if (state == GameState::PAUSED) {
+                    state = GameState::RUNNING;
+                    // Nach der Pause nicht sofort einen verspaeteten Tick nachholen
+                    nextTickAt = std::chrono::steady_clock::now() + tickInterval();
+                }
+                break;
+            case SDLK_r:
+                if (state == GameState::GAME_OVER) {
+                    reset();
+                }
+                break;
+            case SDLK_BACKSPACE:
+                rewind(REWIND_STEP);
+                break;
+            case SDLK_F5: {
+                GameSnapshot snapshot;
+                saveSnapshot(snapshot);
+                if (snapshot.saveToFile(SNAPSHOT_FILE)) {
+                    std::cout << "Snapshot gespeichert: " << SNAPSHOT_FILE << " (Tick " << tickCount << ", "
+                              << snapshot.size() << " Bytes)\n";
+                }
+                break;
+            }
+            case SDLK_F9: {
+                GameSnapshot snapshot;
+                if (snapshot.loadFromFile(SNAPSHOT_FILE) && restoreSnapshot(snapshot)) {
+                    state = GameState::PAUSED;
+                    std::cout << "Snapshot geladen: Tick " << tickCount << " (P zum Fortsetzen)\n";
+                }
+                break;
+            }
+            case SDLK_q:
+            case SDLK_ESCAPE:
+                return false;
         }
     }
     return true;
@@ -486,12 +1010,40 @@ void Game::run() {
     bool running = true;
 
     while (running) {
-        running = handleEvents();
+        // Ereignisgesteuert: bis zum naechsten faelligen Tick (oder Frame) schlafen oder bis ein Event kommt.
+        // Pausiert / Game Over gibt es keinen Tick, dann wird nur auf Eingaben gewartet.
+        SDL_Event e;
+        int hasEvent;
+        if (state == GameState::RUNNING) {
+            const auto now = std::chrono::steady_clock::now();
+            auto wakeAt = speedMultiplier == UNLIMITED_SPEED ? now : nextTickAt;
+            if (needsRender) {
+                wakeAt = std::min(wakeAt, lastRenderAt + MIN_FRAME_TIME);
+            }
+            const auto wait = std::chrono::ceil<std::chrono::milliseconds>(wakeAt - now).count();
+            hasEvent = SDL_WaitEventTimeout(&e, static_cast<int>(std::max<long long>(0, wait)));
+        } else {
+            hasEvent = SDL_WaitEvent(&e);
+        }
+        if (hasEvent) {
+            running = handleEvent(e) && handleEvents();
+        }
+
         update();
-        render();
 
-        SDL_Delay(16); // ~60 FPS
+        // Nur zeichnen, wenn ein Tick oder ein Event etwas veraendert hat, und bei hohem Tempo
+        // hoechstens ~60 mal pro Sekunde (die Ticks dazwischen werden nicht einzeln gezeigt)
+        const auto now = std::chrono::steady_clock::now();
+        if (needsRender && (state != GameState::RUNNING || now - lastRenderAt >= MIN_FRAME_TIME)) {
+            render();
+            needsRender = false;
+            lastRenderAt = now;
+        }
     }
 
+    if (inputLatencySamples > 0) {
+        SNAKE_LOG_INFO("Eingabe-Latenz: %.1f ms im Mittel ueber %d Eingaben",
+                       inputLatencySumMs / inputLatencySamples, inputLatencySamples);
+    }
     cleanup();
-}
\ No newline at end of file
+}
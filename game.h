@@ -2,12 +2,25 @@
 
 #include <random>
 #include <chrono>
+#include <limits>
 #include <vector>
 #include "grid.h"
 #include "Snake.h"
 #include "Pathfinder.h"
 #include "ObstacleGenerator.h"
 #include "HUD.h"
+#include "HamiltonCycle.h"
+#include "MoveSafety.h"
+#include "Arena.h"
+#include "Log.h"
+#include "TrajectoryWriter.h"
+#include "Snapshot.h"
+#include "FoodIndex.h"
+#include "FrameRenderer.h"
+#include "VideoExporter.h"
+#include "SlicedSearch.h"
+#include "PathPlanner.h"
+#include "SpeculativePlanner.h"
 
 enum class GameState{
     RUNNING,
@@ -18,7 +31,7 @@ enum class GameState{
 class Game{
 private:
     Grid grid;
-    std::vector<Point> foodPositions;
+    FoodIndex foodIndex;                          // alle Essen, raeumlich einsortiert
     Snake snake;
     GameState state;
     int score;
@@ -27,8 +40,25 @@ private:
     bool autoPlay = false;                        // AutoPlay Status
     std::vector<Direction> currentPath;           // Pfad als Richtungen
     std::vector<Point> currentPathPoints;         // Pfad als Punkte für Rendering
+    std::vector<Point> foodCandidates;            // naechste Essen, falls das naechste nicht erreichbar ist
+    static constexpr size_t FOOD_CANDIDATES = PathPlanner::FOOD_CANDIDATES;
+    double lastTickMicros = 0.0;                  // HUD-Statistik: Dauer des letzten Ticks
+    size_t lastNodesExpanded = 0;                 // HUD-Statistik: expandierte Knoten im letzten Tick
     std::unique_ptr<Pathfinder> pathfinder;
     Pathfinder::Algorithm currentAlgorithm;
+    MoveSafety moveSafety;                        // verwirft Zuege in zu kleine Taschen
+    PathPlanner planner;                          // Essen-Suche mit Ausweich-Essen und Schwanz-Vorausschau
+    // Spekulation (--speculate): der naechste Pfad wird direkt nach dem Zug im Hintergrund geplant.
+    // stateStamp aendert sich bei Reset/Restore/Algorithmuswechsel, wallsVersion bei neuen Waenden
+    SpeculativePlanner speculative;
+    uint64_t stateStamp = 0;
+    uint64_t wallsVersion = 0;
+    // Zeitscheiben (--budget=): pro Tick hoechstens searchBudget, bis dahin eine Teilantwort
+    SlicedSearch slicedSearch;
+    SlicedSearch::Budget searchBudget;
+    void updateSlicedPathfinding(Point start);
+    // Pfad fuer Overlay/Video/HUD: im Zeitscheiben-Modus der Weg der Suche, sonst currentPathPoints
+    [[nodiscard]] const std::vector<Point> &displayedPath() const;
 
 
     // SDL Komponenten
@@ -40,16 +70,68 @@ private:
 
     // Spiel Einstellungen
     int maxFoodItems = 3; // Maximum number of food items on the grid at once
-    Uint32 lastMoveTime;
-    Uint32 moveDelay; // milliseconds between moves
+    Uint32 moveDelay; // milliseconds between moves (bei 1x)
+    bool needsRender = true;        // nur neu zeichnen, wenn sich etwas geaendert hat
+
+    // Tempo: Vielfaches von moveDelay (1x..1000x) oder UNLIMITED_SPEED (so schnell wie moeglich)
+    int speedMultiplier = 1;
+    int renderEveryTicks = 1000;    // unbegrenzt: so viele Ticks zwischen zwei Frames
+    std::chrono::steady_clock::time_point nextTickAt = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point lastRenderAt{};
+    // Erreichte Ticks pro Sekunde (ueber ~500ms gemittelt)
+    std::chrono::steady_clock::time_point tickRateWindowStart = std::chrono::steady_clock::now();
+    int tickRateWindowTicks = 0;
+    double ticksPerSecond = 0.0;
+
+    // Eingabe-Latenz: Zeitstempel des Tastendrucks bis zum Zug, der ihn ausfuehrt
+    bool inputPending = false;
+    Uint32 inputTimestamp = 0;
+    double lastInputLatencyMs = 0.0;
+    double inputLatencySumMs = 0.0;
+    int inputLatencySamples = 0;
 
     // Random nummer generateror
     std::mt19937 rng;
 
+    // Speicher fuer kurzlebige Puffer (Hindernis-Pruefung, Hamilton-Bau), wird jeden Tick zurueckgesetzt
+    Arena tickArena;
+
     //Level und Hindernisse
     int level = 1;
     ObstacleGenerator obstacleGenerator;
 
+    // Hamilton-Autopilot (einmal pro Level berechnet)
+    HamiltonCycle hamiltonCycle;
+    bool hamiltonMode = false;
+    bool hamiltonDirty = true;      // Level hat sich geaendert, Kreis neu berechnen
+    bool hamiltonEngaged = false;   // Body liegt in Kreisreihenfolge, Abkuerzungen sind sicher
+
+    // Trainingsdaten-Aufzeichnung (--record=), observation ist das Brett nach dem Tick
+    TrajectoryWriter recorder;
+    std::vector<uint8_t> observation;
+    void recordTick(Direction action, int8_t reward, bool done);
+
+    // Video-Export (--video=): nach jedem Tick ein Frame aus dem Software-Renderer, ohne SDL
+    FrameRenderer frameRenderer;
+    VideoExporter video;
+    void captureFrame();
+
+    // Zurueckspulen: ein Snapshot vor jedem Tick, BACKSPACE springt REWIND_STEP Ticks zurueck
+    static constexpr size_t REWIND_HISTORY = 256;
+    static constexpr size_t REWIND_STEP = 20;
+    SnapshotRing history;
+    std::vector<uint32_t> snapshotIndices;      // Puffer fuer restoreSnapshot (Body/Essen)
+    // Zustandsworte der Zufallsgeneratoren, nur ein Cache fuer saveSnapshot (daher mutable)
+    mutable EngineState rngState;
+    mutable EngineState obstacleRngState;
+    uint64_t tickCount = 0;
+    [[nodiscard]] static size_t snapshotBytes(int breite, int hohe);
+    void rewind(size_t ticks);
+
+    // Ein Tick inklusive Messung (Tick-Zeit, Eingabe-Latenz, Ticks/s)
+    void runTimedTick();
+    [[nodiscard]] std::chrono::microseconds tickInterval() const;
+
     // Hilfer Methoden fuer Essen spawen und entfernen
     void spawnFood();
     void removeFood(const Point& foodPos);
@@ -65,6 +147,7 @@ public:
     // Spiel loop Methoden
     void processInput(Direction dir);
     void update();
+    void tick();        // ein Simulationsschritt, unabhaengig von der Zeit (auch headless nutzbar)
     void render();
 
     // Spiel status Methoden
@@ -73,30 +156,69 @@ public:
     void togglePause() { state = (state == GameState::PAUSED) ? GameState::RUNNING : GameState::PAUSED; }
     void reset();
 
+    // Tempo: 1..MAX_SPEED oder UNLIMITED_SPEED
+    static constexpr int UNLIMITED_SPEED = 0;
+    static constexpr int MAX_SPEED = 1000;
+    void setSpeed(int multiplier);
+    void changeSpeed(int steps);    // +1 = naechste Stufe schneller, -1 = langsamer
+    int getSpeed() const { return speedMultiplier; }
+    void setRenderEveryTicks(int ticks) { renderEveryTicks = std::max(1, ticks); }
+
+    // Aufzeichnung pro Tick: Aktion, Belohnung (+1 Essen, -1 Tod) und Brett
+    bool startRecording(const std::string &path) { return recorder.open(path, grid.getBreite(), grid.getHohe()); }
+    void stopRecording() { recorder.close(); }
+    const TrajectoryWriter& getRecorder() const { return recorder; }
+
+    // Video pro Tick (.y4m oder PPM-Stream), cellPixels = 0: Zellgroesse des Fensters
+    bool startVideo(const std::string &path, int cellPixels = 0, int fps = 30);
+    void stopVideo() { video.close(); }
+    const VideoExporter& getVideo() const { return video; }
+
+    // Kompletter Spielzustand (Grid, Schlange, Essen, Level, Score, Zufallszustaende) als Blob.
+    // Beides dauert nur Mikrosekunden; restore liefert false bei falscher Grid-Groesse oder kaputtem Blob
+    void saveSnapshot(GameSnapshot &snapshot) const;
+    bool restoreSnapshot(const GameSnapshot &snapshot);
+    uint64_t getTickCount() const { return tickCount; }
+    size_t getLastNodesExpanded() const { return lastNodesExpanded; }
+
     // Essen Einstellungen
     void setMaxFoodItems(int count) { maxFoodItems = count; }
     int getMaxFoodItems() const { return maxFoodItems; }
 
     // Inhalte des Spiels oder Objekte des Spiels
     int getScore() const { return score; }
+    int getLevel() const { return level; }
     GameState getState() const { return state; }
     void setState(GameState newState) { state = newState; }
     const Grid& getGrid() const { return grid; }
     const Snake& getSnake() const { return snake; }
-    const std::vector<Point>& getFoodPositions() const { return foodPositions; }
+    const std::vector<Point>& getFoodPositions() const { return foodIndex.positions(); }
+    const Arena& getTickArena() const { return tickArena; }
 
     void generateObstaclesForLevel();
 
     // Pathfinding-Funktionen
     void setAlgorithm(Pathfinder::Algorithm algo);
+    // Budget pro Tick fuer die Suche zum Essen (Knoten und/oder Zeit), unbegrenzt = normale Pathfinder
+    void setSearchBudget(const SlicedSearch::Budget &budget) { searchBudget = budget; slicedSearch.cancel(); }
+    const SlicedSearch& getSlicedSearch() const { return slicedSearch; }
+    // Hintergrund-Planer an/aus (startet/beendet den Thread, also nicht mitten in einer Messung)
+    void setSpeculative(bool enabled) { if (enabled) speculative.start(); else speculative.stop(); }
+    const SpeculativePlanner& getSpeculative() const { return speculative; }
     void updatePathfinding();
     Direction getNextAIMove();
+    // Simuliert den Pfad und prueft, ob der Schwanz danach noch erreichbar ist
+    bool leavesTailReachable(const std::vector<Point>& pathPoints);
     void toggleAutoPlay();
+    bool isAutoPlay() const { return autoPlay; }
+    void toggleHamiltonMode();
+    Direction getHamiltonMove();
 
     // sucht den naechsten Essen in der Naehe von einer Position
     Point findClosestFood(const Point& position) const;
 
     // SDL-spezifische Methoden
     bool handleEvents();
+    bool handleEvent(const SDL_Event& e);
     void run();
 };
\ No newline at end of file
@@ -1,6 +1,6 @@
 #include "grid.h"
 
-Grid::Grid(int breite, int hohe,bool createBorder):breite(breite),hohe(hohe),cells(hohe,std::vector<CellType>(breite,CellType::EMPTY)){
+Grid::Grid(int breite, int hohe,bool createBorder):breite(breite),hohe(hohe),cells(static_cast<size_t>(breite) * hohe,CellType::EMPTY){
     if(createBorder){
         Grid::initializeWalls();
     }
@@ -16,6 +16,7 @@ void Grid::initializeWalls() {
         setCell(0,y,CellType::WALL);
         setCell(breite-1,y,CellType::WALL);
     }
+    bordered = true;
 }
 
 //Auf Cells zugreifen
@@ -26,14 +27,18 @@ CellType Grid::getCell(int x , int y) const{
     if (!isInBounds(x,y)) {
         return CellType::WALL;
     }
-    return cells[y][x];
+    return cells[y * breite + x];
 };
 void Grid::setCell(const Point &p, CellType type){
     setCell(p.x,p.y,type);
 };
 void Grid::setCell(int x,int y,CellType type){
     if (isInBounds(x,y)) {
-        cells[y][x] = type;
+        cells[y * breite + x] = type;
+        // Ein geoeffneter Randpunkt hebt die Rand-Garantie auf
+        if (type != CellType::WALL && (x == 0 || y == 0 || x == breite - 1 || y == hohe - 1)) {
+            bordered = false;
+        }
     }
 };
 
@@ -50,28 +55,23 @@ bool Grid::isObstacle(const Point &p) const {
 }
 //setzen von cellen auf leer
 void Grid::clear(CellType type){
-    for(int y = 0; y < hohe; y++){
-        for(int x = 0; x < breite; x++){
-            if (cells[y][x] != CellType::WALL){
-                cells[y][x] = type;
-            }
+    for(CellType &cell : cells){
+        if (cell != CellType::WALL){
+            cell = type;
         }
     }
 };
 
-void Grid::setPath(const std::vector<Point>& path) {
-    currentPath = path;
-}
-
-void Grid::clearPath() {
-    currentPath.clear();
+void Grid::copyCellsFrom(const Grid &other) {
+    cells = other.cells;
+    bordered = other.bordered;
 }
 void Grid::clearObstacles() {
     // Durchlaufe nur die inneren Zellen, also x=1..breite-2, y=1..hohe-2
     for (int y = 1; y < hohe - 1; ++y) {
         for (int x = 1; x < breite - 1; ++x) {
-            if (cells[y][x] == CellType::WALL) {
-                cells[y][x] = CellType::EMPTY;
+            if (cells[y * breite + x] == CellType::WALL) {
+                cells[y * breite + x] = CellType::EMPTY;
             }
         }
     }
@@ -82,7 +82,8 @@ void Grid::renderToSDL(SDL_Renderer* renderer, int cellSize) const {
         for (int x = 0; x < breite; ++x) {
             SDL_Rect rect = {x * cellSize, y * cellSize, cellSize, cellSize};
 
-            switch (cells[y][x]) {
+            const CellType cell = cells[y * breite + x];
+            switch (cell) {
                 case CellType::WALL:
                     SDL_SetRenderDrawColor(renderer, 128, 128, 128, 255); // Grau
                     break;
@@ -99,7 +100,7 @@ void Grid::renderToSDL(SDL_Renderer* renderer, int cellSize) const {
 
             SDL_RenderFillRect(renderer, &rect);
 
-            if (cells[y][x] != CellType::EMPTY) {
+            if (cell != CellType::EMPTY) {
                 SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // Weiße Grenze(border)
                 SDL_RenderDrawRect(renderer, &rect);
             }
@@ -107,16 +108,16 @@ void Grid::renderToSDL(SDL_Renderer* renderer, int cellSize) const {
     }
 }
 //Separates Pfad-Overlay
-void Grid::renderPathOverlay(SDL_Renderer* renderer, int cellSize) const {
-    if (currentPath.empty()) return;
+void Grid::renderPathOverlay(SDL_Renderer* renderer, int cellSize, const std::vector<Point>& path) const {
+    if (path.empty()) return;
 
     // Pfad mit halbtransparenten Gelb rendern
     SDL_SetRenderDrawColor(renderer, 255, 255, 0, 100); // Gelb mit Transparenz
 
-    for (const Point& pathPoint : currentPath) {
+    for (const Point& pathPoint : path) {
         if (isInBounds(pathPoint)) {
             // Nur rendern wenn die Zelle leer ist (nicht über Snake/Food/Wände)
-            if (cells[pathPoint.y][pathPoint.x] == CellType::EMPTY) {
+            if (cells[pathPoint.y * breite + pathPoint.x] == CellType::EMPTY) {
                 SDL_Rect rect = {
                         pathPoint.x * cellSize + 2,  // Kleiner Offset für bessere Sicht
                         pathPoint.y * cellSize + 2,
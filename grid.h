@@ -8,8 +8,10 @@ class Grid{
     private:
         int breite;
         int hohe;
-        std::vector<std::vector<CellType>> cells;
-        std::vector<Point> currentPath;
+        // Flach gespeichert (Index = y * breite + x), damit Suchkerne direkt darauf arbeiten koennen
+        std::vector<CellType> cells;
+        // Rand ist komplett Wand: Suchkerne koennen dann auf Bounds-Checks verzichten
+        bool bordered = false;
 
     public:
         Grid(int breite, int hohe,bool creatborder = true);
@@ -17,6 +19,8 @@ class Grid{
         //Getters
         [[nodiscard]] int getBreite() const { return breite; }
         [[nodiscard]] int getHohe() const { return hohe; }
+        [[nodiscard]] bool hasBorder() const { return bordered; }
+        [[nodiscard]] const CellType* data() const { return cells.data(); }
 
         //Auf Cells zugreifen
         [[nodiscard]] CellType getCell( const Point &p) const;
@@ -35,14 +39,14 @@ class Grid{
         //setzen von cellen auf leer
         void clear(CellType type = CellType::EMPTY);
 
-        // Pfad-Management
-        void setPath(const std::vector<Point>& path);
-        void clearPath();
-
         void clearObstacles();
 
+        // Zellen und Rand von other uebernehmen (gleiche Groesse, allokiert nicht)
+        void copyCellsFrom(const Grid &other);
+
         //printen des grids
         void renderToSDL(SDL_Renderer* renderer, int cellSize) const;
-        void renderPathOverlay(SDL_Renderer* renderer, int cellSize)const;
+        // Pfad gehoert dem Spiel (es rendert ihn direkt, statt ihn jeden Tick ins Grid zu kopieren)
+        void renderPathOverlay(SDL_Renderer* renderer, int cellSize, const std::vector<Point>& path)const;
 };
 #endif //SNAKEGAME_GRID_H
@@ -5,7 +5,11 @@
 
 #include <SDL.h>
 #include "game.h"
+#include "Benchmark.h"
+#include "Simulation.h"
+#include "Log.h"
 #include <iostream>
+#include <string>
 
 int main(int argc, char* argv[]) {
 #ifdef SDL_MAIN_HANDLED
@@ -20,8 +24,119 @@ int main(int argc, char* argv[]) {
     const int FENSTER_BREITE = 800;
     const int FENSTER_HOHE = 600;
 
+    // Kommandozeile: --benchmark [--ticks=N] startet den Headless-Benchmark statt des Spiels,
+    // --multi=N [--threads=T] [--ticks=N] den Stresstest mit N KI-Schlangen,
+    // --speed=N|max [--render-every=N] startet das Spiel gleich im Turbo-Modus,
+    // --record=datei zeichnet jeden Tick als Trainingsdaten auf (auch mit --benchmark),
+    // --grid=BxH aendert die Spielfeldgroesse (mit --benchmark: Pfadanfragen HPA* gegen BFS),
+    // --resume=datei setzt einen mit F5 gespeicherten Snapshot fort (auch mit --benchmark),
+    // --food=N laesst den Benchmark mit N Essen gleichzeitig laufen,
+    // --scen=datei.scen schickt mit --benchmark alle MovingAI-Szenarien durch jeden Pfadfinder,
+    // --video=datei.y4m|.ppm rendert jeden Tick ohne Fenster in ein Video (auch mit --benchmark),
+    // --video-cell=N Pixel pro Zelle im Video,
+    // --budget=N / --budget-us=N begrenzen die Suche pro Tick auf N Knoten / Mikrosekunden (Zeitscheiben),
+    // --speculate plant den naechsten AutoPlay-Pfad schon im Hintergrund (auch mit --benchmark)
+    bool benchmark = false;
+    int speed = 1;
+    int renderEvery = 0;
+    bool gridGiven = false;
+    bool ticksGiven = false;
+    bool videoCellGiven = false;
+    Benchmark::Options benchmarkOptions;
+    Simulation::Options simulationOptions;
+    bool multi = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--benchmark") {
+            benchmark = true;
+        } else if (arg.rfind("--ticks=", 0) == 0) {
+            benchmarkOptions.ticks = std::stoi(arg.substr(8));
+            ticksGiven = true;
+        } else if (arg.rfind("--multi=", 0) == 0) {
+            multi = true;
+            simulationOptions.snakes = std::stoi(arg.substr(8));
+        } else if (arg.rfind("--threads=", 0) == 0) {
+            simulationOptions.threads = static_cast<unsigned>(std::stoi(arg.substr(10)));
+        } else if (arg.rfind("--speed=", 0) == 0) {
+            const std::string value = arg.substr(8);
+            speed = value == "max" ? Game::UNLIMITED_SPEED : std::stoi(value);
+        } else if (arg.rfind("--record=", 0) == 0) {
+            benchmarkOptions.recordPath = arg.substr(9);
+        } else if (arg.rfind("--grid=", 0) == 0) {
+            const size_t x = arg.find('x', 7);
+            if (x != std::string::npos) {
+                benchmarkOptions.breite = std::stoi(arg.substr(7, x - 7));
+                benchmarkOptions.hohe = std::stoi(arg.substr(x + 1));
+                gridGiven = true;
+            }
+        } else if (arg.rfind("--scen=", 0) == 0) {
+            benchmarkOptions.scenarioPath = arg.substr(7);
+        } else if (arg.rfind("--video=", 0) == 0) {
+            benchmarkOptions.videoPath = arg.substr(8);
+        } else if (arg.rfind("--video-cell=", 0) == 0) {
+            benchmarkOptions.videoCellSize = std::stoi(arg.substr(13));
+            videoCellGiven = true;
+        } else if (arg.rfind("--budget=", 0) == 0) {
+            benchmarkOptions.searchNodeBudget = static_cast<size_t>(std::stoll(arg.substr(9)));
+        } else if (arg.rfind("--budget-us=", 0) == 0) {
+            benchmarkOptions.searchMicrosBudget = std::stoi(arg.substr(12));
+        } else if (arg == "--speculate") {
+            benchmarkOptions.speculate = true;
+        } else if (arg.rfind("--food=", 0) == 0) {
+            benchmarkOptions.foodItems = std::stoi(arg.substr(7));
+        } else if (arg.rfind("--resume=", 0) == 0) {
+            benchmarkOptions.resumePath = arg.substr(9);
+        } else if (arg.rfind("--render-every=", 0) == 0) {
+            renderEvery = std::stoi(arg.substr(15));
+        }
+    }
+    // Debug-Meldungen gehen asynchron in eine Datei statt pro Tick auf die Konsole
+    Log::start("snake.log");
+
+    if (multi) {
+        const int result = Simulation::runBenchmark(simulationOptions, ticksGiven ? benchmarkOptions.ticks : 200);
+        Log::stop();
+        return result;
+    }
+    if (benchmark) {
+        const int result = !benchmarkOptions.scenarioPath.empty() ? Benchmark::runScenarios(benchmarkOptions)
+                           : gridGiven ? Benchmark::runQueries(benchmarkOptions) : Benchmark::run(benchmarkOptions);
+        Log::stop();
+        return result;
+    }
+
     try {
-        Game spiel(GRID_BREITE, GRID_HOHE, FENSTER_BREITE, FENSTER_HOHE);
+        Game spiel(gridGiven ? benchmarkOptions.breite : GRID_BREITE, gridGiven ? benchmarkOptions.hohe : GRID_HOHE,
+                   FENSTER_BREITE, FENSTER_HOHE);
+        if (renderEvery > 0) {
+            spiel.setRenderEveryTicks(renderEvery);
+        }
+        if (speed != 1) {
+            spiel.setSpeed(speed);
+        }
+        if (benchmarkOptions.searchNodeBudget > 0 || benchmarkOptions.searchMicrosBudget > 0) {
+            spiel.setSearchBudget({benchmarkOptions.searchNodeBudget,
+                                   std::chrono::microseconds(benchmarkOptions.searchMicrosBudget)});
+        }
+        if (benchmarkOptions.speculate) {
+            spiel.setSpeculative(true);
+        }
+        if (!benchmarkOptions.resumePath.empty()) {
+            GameSnapshot snapshot;
+            if (!snapshot.loadFromFile(benchmarkOptions.resumePath) || !spiel.restoreSnapshot(snapshot)) {
+                Log::stop();
+                return 1;
+            }
+            std::cout << "Fortgesetzt ab Tick " << spiel.getTickCount() << std::endl;
+        }
+        if (!benchmarkOptions.recordPath.empty() && spiel.startRecording(benchmarkOptions.recordPath)) {
+            std::cout << "Aufzeichnung nach " << benchmarkOptions.recordPath << std::endl;
+        }
+        // Ohne --video-cell so gross wie im Fenster
+        if (!benchmarkOptions.videoPath.empty()
+            && spiel.startVideo(benchmarkOptions.videoPath, videoCellGiven ? benchmarkOptions.videoCellSize : 0)) {
+            std::cout << "Video nach " << benchmarkOptions.videoPath << std::endl;
+        }
 
         std::cout << "Starte SDL Schlangen Spiel..." << std::endl;
         std::cout << "Steuerung:" << std::endl;
@@ -29,7 +144,14 @@ int main(int argc, char* argv[]) {
         std::cout << "  S/Pfeil Runter- Nach Unten" << std::endl;
         std::cout << "  A/Pfeil Links - Nach Links" << std::endl;
         std::cout << "  D/Pfeil Rechts- Nach Rechts" << std::endl;
+        std::cout << "  SPACE         - AutoPlay an/aus" << std::endl;
+        std::cout << "  1-6           - BFS / Dijkstra / Distanzfeld / HPA* / D* Lite / Parallele BFS" << std::endl;
+        std::cout << "  H             - Hamilton-Autopilot an/aus (AutoPlay)" << std::endl;
+        std::cout << "  +/-           - Tempo hoch/runter (1x bis 1000x, dann unbegrenzt)" << std::endl;
+        std::cout << "  0             - Tempo zuruecksetzen (1x)" << std::endl;
         std::cout << "  P             - Pause/Fortsetzen" << std::endl;
+        std::cout << "  BACKSPACE     - 20 Ticks zurueckspulen" << std::endl;
+        std::cout << "  F5/F9         - Snapshot speichern/laden (snake.snap)" << std::endl;
         std::cout << "  R             - Neustart (nach Game Over)" << std::endl;
         std::cout << "  Q/Escape      - Beenden" << std::endl;
         std::cout << std::endl;
@@ -38,8 +160,10 @@ int main(int argc, char* argv[]) {
 
     } catch (const std::exception& e) {
         std::cerr << "Fehler: " << e.what() << std::endl;
+        Log::stop();
         return 1;
     }
+    Log::stop();
 
     std::cout << "Spiel beendet. Danke fuers Spielen!" << std::endl;
     return 0;